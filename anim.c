@@ -0,0 +1,546 @@
+/**
+ *
+ * @file    anim.c
+ *
+ * @brief   Led cube animations scheduler source file.
+ *
+ * @details The demo of the ledcube driver drives the cube pins by itself,
+ *          the other animations draw frames shown by the refresh engine.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/pgmspace.h>
+
+/* Project local files. */
+#include "ledcube.h"
+#include "display.h"
+#include "effects.h"
+#include "scroll.h"
+#include "show.h"
+#include "tween.h"
+#include "telemetry.h"
+#include "input.h"
+#include "sync.h"
+#include "trace.h"
+#include "anim.h"
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+static void anim_demo_start(uint8_t id) {
+
+  (void)id;
+  displayStop();
+}
+
+static systime_t anim_demo_step(void) {
+
+  ledCubeDemo();
+
+  return 0;
+}
+
+static void anim_scroll_start(uint8_t id) {
+
+  (void)id;
+  displayStart();
+}
+
+static systime_t anim_scroll_step(void) {
+
+  scrollStep();
+
+  return SCROLL_STEP_PERIOD;
+}
+
+static void anim_effects_start(uint8_t id) {
+
+  effectsStart(id);
+  displayStart();
+}
+
+static void anim_show_start(uint8_t id) {
+
+  (void)id;
+  showStart();
+  displayStart();
+}
+
+static void anim_tween_start(uint8_t id) {
+
+  (void)id;
+  tweenStart();
+  displayStart();
+}
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Animations table, indexed by the animations identifiers.
+ */
+static const anim_t anim_table[ANIM_COUNT] PROGMEM = {
+  {anim_demo_start,     anim_demo_step,     NULL},
+  {anim_scroll_start,   anim_scroll_step,   NULL},
+  {anim_effects_start,  effectsSparkleStep, NULL},
+  {anim_effects_start,  effectsRainStep,    NULL},
+  {anim_effects_start,  effectsFillStep,    NULL},
+  {anim_show_start,     showStep,           showSeek},
+  {anim_tween_start,    tweenStep,          tweenSeek}
+};
+
+/**
+ * @brief   Scheduler state.
+ */
+static struct {
+  /* Animation requested.*/
+  uint8_t selected;
+  /* Animation running.*/
+  uint8_t current;
+  /* Playlist, played in loop when not empty.*/
+  anim_entry_t  list[ANIM_PLAYLIST_SIZE];
+  uint8_t       count;
+  uint8_t       pos;
+  /* Time spent on the current playlist entry.*/
+  uint32_t      elapsed;
+  systime_t     last;
+  /* Number of the next step of the running animation.*/
+  uint16_t      step;
+  /* Step imposed by the synchronization master.*/
+  uint16_t      follow;
+  bool          following;
+  /* Last timecode received, in ticks, and its time of arrival.*/
+  uint32_t      seek;
+  systime_t     seek_time;
+  bool          seeking;
+  /* Time of the next step.*/
+  systime_t     next;
+  /* Animation thread waiting for the next step.*/
+  thread_reference_t  wait;
+  /* The next step must be played right now.*/
+  bool          kicked;
+  /* Deadline statistics.*/
+  anim_stats_t  stats;
+} anim;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Makes the animation thread play its next step now.
+ */
+static void anim_kick_i(void) {
+
+  anim.kicked = true;
+  chThdResumeI(&anim.wait, MSG_OK);
+}
+
+/**
+ * @brief   Handles the input events.
+ * @details Each button press selects the next animation, the brightness is
+ *          changed by @p inputProcess().
+ *
+ * @return  true if another animation was selected.
+ */
+static bool anim_input(void) {
+  uint8_t presses = inputProcess();
+
+  if (presses == 0)
+    return false;
+
+  chSysLock();
+  anim.count    = 0;
+  anim.selected = (anim.selected + presses) % ANIM_COUNT;
+  chSysUnlock();
+
+  return true;
+}
+
+/**
+ * @brief   Moves the playlist to the entry played at a time.
+ * @details The playlist is at most @p ANIM_PLAYLIST_SIZE entries long, the
+ *          time taken does not depend on the time to reach.
+ *
+ * @param[in] t     time since the start of the playlist, in ticks
+ * @return          time since the start of the entry, in ticks.
+ *
+ * @sclass
+ */
+static uint32_t anim_seek_playlist_s(uint32_t t) {
+  uint32_t length, total = 0;
+  uint8_t i;
+
+  for (i = 0; i < anim.count; i++)
+    total += (uint32_t)anim.list[i].seconds * S2ST(1);
+  if (total == 0)
+    return t;
+
+  t %= total;
+  for (i = 0; t >= (length = (uint32_t)anim.list[i].seconds * S2ST(1)); i++)
+    t -= length;
+
+  anim.pos      = i;
+  anim.selected = anim.list[i].id;
+  anim.elapsed  = t;
+  anim.last     = chVTGetSystemTimeX();
+
+  return t;
+}
+
+/**
+ * @brief   Applies the last timecode received.
+ * @details The playlist moves to the entry of the timecode, then the running
+ *          animation to its frame. When the entry is another animation the
+ *          timecode is kept, it is applied again once the animation is
+ *          started.
+ *
+ * @return  true if the next step must be played now: another animation was
+ *          selected or the running one moved to another frame.
+ */
+static bool anim_seek(void) {
+  bool (*seek)(uint32_t);
+  uint32_t t;
+
+  chSysLock();
+  if (!anim.seeking) {
+    chSysUnlock();
+    return false;
+  }
+  t = anim.seek + (systime_t)(chVTGetSystemTimeX() - anim.seek_time);
+  if (anim.count > 0)
+    t = anim_seek_playlist_s(t);
+  if (anim.selected != anim.current) {
+    chSysUnlock();
+    return true;
+  }
+  anim.seeking = false;
+  chSysUnlock();
+
+  seek = (bool (*)(uint32_t))pgm_read_ptr(&anim_table[anim.current].seek);
+
+  return (seek != NULL) && seek(t);
+}
+
+/**
+ * @brief   Waits for the time of the next step.
+ * @details Steps are scheduled on absolute times, the time taken by a step
+ *          does not delay the following ones. A follower waits for the tick
+ *          of the master and only steps on its own when a tick is missing
+ *          for one and a half step.
+ *          The input events and the timecodes are handled while waiting,
+ *          only a kick, or a timecode moving the animation, plays the next
+ *          step early and then becomes the time reference of the following
+ *          ones.
+ *
+ * @param[in] delay     time between the last step and the next one
+ */
+static void anim_wait(systime_t delay) {
+  systime_t now, timeout, end;
+  bool play;
+
+  chSysLock();
+  now = chVTGetSystemTimeX();
+  anim.next += delay;
+
+  if (syncGetRole() == SYNC_FOLLOWER) {
+    timeout = delay + (delay >> 1);
+  }
+  else {
+    timeout = anim.next - now;
+
+    /* Late, steps right now and takes the current time as reference. A
+       step due right now is on time.*/
+    if ((int16_t)timeout < 0) {
+      anim.stats.missed++;
+      if ((systime_t)(now - anim.next) > anim.stats.worst)
+        anim.stats.worst = now - anim.next;
+      anim.next = now;
+      timeout = 0;
+    }
+  }
+
+  end = now + timeout;
+  while ((timeout > 0) && !anim.kicked) {
+    if (chThdSuspendTimeoutS(&anim.wait, timeout) == MSG_TIMEOUT)
+      break;
+
+    /* Woken by an input event or a timecode, a press or a seek plays the
+       next step now.*/
+    chSysUnlock();
+    play = anim_input();
+    if (anim_seek())
+      play = true;
+    chSysLock();
+    if (play)
+      anim.kicked = true;
+    timeout = end - chVTGetSystemTimeX();
+    if ((int16_t)timeout <= 0)
+      break;
+  }
+
+  if (anim.kicked) {
+    anim.kicked = false;
+    anim.next   = chVTGetSystemTimeX();
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Moves to the next playlist entry when the current one is over.
+ * @details The time is accumulated step by step, the system time is too
+ *          short to count whole minutes.
+ */
+static void anim_playlist_update(void) {
+  systime_t now;
+
+  chSysLock();
+  if (anim.count > 0) {
+    now = chVTGetSystemTimeX();
+    anim.elapsed += (systime_t)(now - anim.last);
+    anim.last = now;
+
+    if (anim.elapsed >= ((uint32_t)anim.list[anim.pos].seconds * S2ST(1))) {
+      anim.elapsed = 0;
+      if (++anim.pos >= anim.count)
+        anim.pos = 0;
+      anim.selected = anim.list[anim.pos].id;
+    }
+  }
+  chSysUnlock();
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Initializes the scheduler, the demo is selected.
+ */
+void animInit(void) {
+
+  anim.selected = ANIM_DEMO;
+  anim.current  = ANIM_COUNT;
+  anim.count    = 0;
+  anim.next     = chVTGetSystemTime();
+}
+
+/**
+ * @brief   Selects the animation to play, the playlist is stopped.
+ * @note    The switch happens once the running step is over.
+ *
+ * @param[in] id    animation identifier, unknown ones are ignored
+ */
+void animSelect(uint8_t id) {
+
+  if (id < ANIM_COUNT) {
+    chSysLock();
+    anim.count    = 0;
+    anim.selected = id;
+    anim_kick_i();
+    chSchRescheduleS();
+    chSysUnlock();
+  }
+}
+
+/**
+ * @brief   Wakes the animation thread up to handle the input events.
+ * @details The events are handled without waiting for the end of the
+ *          current step period, the next step is only played early when a
+ *          button press selects another animation.
+ *
+ * @iclass
+ */
+void animWakeI(void) {
+
+  chThdResumeI(&anim.wait, MSG_OK);
+}
+
+/**
+ * @brief   Plays a step imposed by the synchronization master.
+ * @details The step is played right away and becomes the time reference of
+ *          the following ones.
+ *
+ * @param[in] id    animation of the master
+ * @param[in] step  step of the master
+ * @return          ticks between now and the time this cube would have
+ *                  played the step on its own, positive when late.
+ */
+int16_t animFollow(uint8_t id, uint16_t step) {
+  int16_t late;
+
+  if (id >= ANIM_COUNT)
+    return 0;
+
+  chSysLock();
+  late = (int16_t)(chVTGetSystemTimeX() - anim.next);
+  anim.count     = 0;
+  anim.selected  = id;
+  anim.follow    = step;
+  anim.following = true;
+  anim_kick_i();
+  chSchRescheduleS();
+  chSysUnlock();
+
+  return late;
+}
+
+/**
+ * @brief   Seeks the playlist, or the selected animation, to a time.
+ * @details The animation thread is woken up to do the seek, the time
+ *          elapsed since the call is added to @p ms. The next step is played
+ *          at once when the animation moves, nothing changes when it is
+ *          less than one frame away. Animations which cannot seek only
+ *          follow the playlist entries.
+ *
+ * @param[in] ms    time since the start of the playlist, or of the
+ *                  animation when there is no playlist, in ms
+ */
+void animSeek(uint32_t ms) {
+  uint32_t t;
+
+  /* Split, the product of the ms by the frequency overflows in minutes.*/
+  t = (ms / 1000) * CH_CFG_ST_FREQUENCY +
+      ((ms % 1000) * CH_CFG_ST_FREQUENCY) / 1000;
+
+  chSysLock();
+  anim.seek      = t;
+  anim.seek_time = chVTGetSystemTimeX();
+  anim.seeking   = true;
+  chThdResumeI(&anim.wait, MSG_OK);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Plays the animations of a playlist in loop.
+ * @note    Entries with an unknown animation are dropped.
+ *
+ * @param[in] list  playlist entries
+ * @param[in] n     number of entries, zero stops the playlist
+ */
+void animSetPlaylist(const anim_entry_t *list, uint8_t n) {
+  uint8_t i, count = 0;
+
+  if (n > ANIM_PLAYLIST_SIZE)
+    n = ANIM_PLAYLIST_SIZE;
+
+  chSysLock();
+  for (i = 0; i < n; i++) {
+    if (list[i].id < ANIM_COUNT)
+      anim.list[count++] = list[i];
+  }
+  anim.count   = count;
+  anim.pos     = 0;
+  anim.elapsed = 0;
+  anim.last    = chVTGetSystemTimeX();
+  if (count > 0)
+    anim.selected = anim.list[0].id;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the playlist.
+ *
+ * @param[out] list     playlist entries, @p ANIM_PLAYLIST_SIZE at most
+ * @return              the number of entries, zero when the playlist is
+ *                      stopped.
+ */
+uint8_t animGetPlaylist(anim_entry_t *list) {
+  uint8_t i, n;
+
+  chSysLock();
+  n = anim.count;
+  for (i = 0; i < n; i++)
+    list[i] = anim.list[i];
+  chSysUnlock();
+
+  return n;
+}
+
+/**
+ * @brief   Returns the selected animation.
+ *
+ * @return  the animation identifier.
+ */
+uint8_t animGetSelected(void) {
+
+  return anim.selected;
+}
+
+/**
+ * @brief   Returns the deadline statistics of the animations.
+ *
+ * @param[out] sp   statistics
+ *
+ * @iclass
+ */
+void animGetStatsI(anim_stats_t *sp) {
+
+  *sp = anim.stats;
+}
+
+/**
+ * @brief   Plays one step of the selected animation and waits for the time
+ *          of the next one.
+ * @note    Called in loop by the animation thread.
+ */
+void animRun(void) {
+  const anim_t *ap;
+  systime_t delay;
+  uint16_t step;
+
+  anim_playlist_update();
+  (void)anim_input();
+
+  /* The timecode may select another playlist entry.*/
+  (void)anim_seek();
+
+  chSysLock();
+  if (anim.current != anim.selected) {
+    anim.current = anim.selected;
+    anim.step = 0;
+    chSysUnlock();
+#if TRACE_ENABLE == TRUE
+    traceStart(anim.current);
+#endif
+    ap = &anim_table[anim.current];
+    ((void (*)(uint8_t))pgm_read_ptr(&ap->start))(anim.current);
+    chSysLock();
+  }
+  if (anim.following) {
+    anim.step = anim.follow;
+    anim.next = chVTGetSystemTimeX();
+    anim.following = false;
+  }
+  step = anim.step++;
+  anim.stats.steps++;
+  chSysUnlock();
+
+  /* Moves the started animation to the frame of the timecode.*/
+  (void)anim_seek();
+
+  ap = &anim_table[anim.current];
+  delay = ((systime_t (*)(void))pgm_read_ptr(&ap->step))();
+
+  if (syncGetRole() == SYNC_MASTER)
+    syncSendTick(anim.current, step);
+
+  telemetryStep();
+
+  if (delay > 0)
+    anim_wait(delay);
+  else
+    anim.next = chVTGetSystemTime();
+}
@@ -0,0 +1,113 @@
+/**
+ *
+ * @file    anim.h
+ *
+ * @brief   Led cube animations scheduler header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _ANIM_H_
+#define _ANIM_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @name    Animations identifiers
+ * @{
+ */
+#define ANIM_DEMO                 0
+#define ANIM_SCROLL               1
+#define ANIM_SPARKLE              2
+#define ANIM_RAIN                 3
+#define ANIM_FILL                 4
+#define ANIM_SHOW                 5
+#define ANIM_TWEEN                6
+#define ANIM_COUNT                7
+/** @} */
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Maximum number of playlist entries.
+ */
+#if !defined(ANIM_PLAYLIST_SIZE)
+#define ANIM_PLAYLIST_SIZE        8
+#endif
+
+/*==========================================================================*/
+/* Data structures and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Animation descriptor.
+ */
+typedef struct {
+  /* Prepares the animation, called when it is selected.*/
+  void      (*start)(uint8_t id);
+  /* Draws the next frame, returns the time until the following one.*/
+  systime_t (*step)(void);
+  /* Moves the next frame to the one shown a number of ticks after the
+     start of the animation, returns false when it was already there.
+     NULL when the animation cannot seek.*/
+  bool      (*seek)(uint32_t ticks);
+} anim_t;
+
+/**
+ * @brief   Playlist entry.
+ */
+typedef struct {
+  /* Animation identifier.*/
+  uint8_t   id;
+  /* Time the animation is played.*/
+  uint8_t   seconds;
+} anim_entry_t;
+
+/**
+ * @brief   Animations deadline statistics.
+ */
+typedef struct {
+  /* Steps played.*/
+  uint16_t  steps;
+  /* Steps which started after their time.*/
+  uint16_t  missed;
+  /* Worst overrun.*/
+  systime_t worst;
+} anim_stats_t;
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void animInit(void);
+  void animSelect(uint8_t id);
+  void animSetPlaylist(const anim_entry_t *list, uint8_t n);
+  uint8_t animGetPlaylist(anim_entry_t *list);
+  int16_t animFollow(uint8_t id, uint16_t step);
+  void animSeek(uint32_t ms);
+  uint8_t animGetSelected(void);
+  void animWakeI(void);
+  void animGetStatsI(anim_stats_t *sp);
+  void animRun(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ANIM_H_ */
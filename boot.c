@@ -0,0 +1,194 @@
+/**
+ *
+ * @file    boot.c
+ *
+ * @brief   Led cube boot sequence source file.
+ *
+ * @details The cube shows a frame stored in flash as soon as the kernel
+ *          runs, everything else is initialized after it.
+ *          The boot time is measured from the entry of main(): Timer 2 runs
+ *          at F_CPU / 1024 until the HAL is initialized, the system time
+ *          takes over from there. Both count 64 us ticks at 16 MHz. Timer 1
+ *          is the system timer, the 8 bits of Timer 2 only count 16.4 ms:
+ *          a longer halInit() is caught by the overflow flag and the boot
+ *          time is then reported as not known.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/pgmspace.h>
+#include <avr/wdt.h>
+
+/* Project local files. */
+#include "display.h"
+#include "boot.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Duration of a Timer 2 tick, in us.
+ */
+#define BOOT_TIMER_TICK_US        (1024000000UL / F_CPU)
+
+/**
+ * @brief   Longest time Timer 2 counts, in us.
+ */
+#define BOOT_TIMER_RANGE_US       (256UL * BOOT_TIMER_TICK_US)
+
+/**
+ * @brief   Frame shown while booting, the edges of the cube.
+ */
+static const display_frame_t boot_frame PROGMEM = {
+  {0x07, 0x05, 0x07,
+   0x05, 0x00, 0x05,
+   0x07, 0x05, 0x07}
+};
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Boot measurements.
+ */
+static struct {
+  /* Timer 2 ticks from main() to the end of halInit(), and Timer 2
+     wrapped meanwhile.*/
+  uint8_t   hal_ticks;
+  bool      hal_overflow;
+  /* System time at the end of halInit().*/
+  systime_t hal_time;
+  /* Reset flags of MCUSR.*/
+  uint8_t   reset_cause;
+} boot;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Prints a string stored in flash.
+ *
+ * @param[in] chp   stream to print on
+ * @param[in] p     string, in flash
+ */
+static void boot_put_P(BaseSequentialStream *chp, const char *p) {
+  char c;
+
+  while ((c = pgm_read_byte(p++)) != '\0')
+    streamPut(chp, c);
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Starts the boot time measurement.
+ * @details The watchdog stays enabled after a watchdog reset, it is
+ *          switched off until the monitor takes it over.
+ * @note    Must be the first call of main().
+ */
+void bootStart(void) {
+
+  boot.reset_cause = MCUSR;
+  MCUSR = 0;
+  wdt_disable();
+
+  TCNT2  = 0;
+  TIFR2  = (1 << TOV2);
+  TCCR2A = 0;
+  TCCR2B = (1 << CS22) | (1 << CS21) | (1 << CS20);
+}
+
+/**
+ * @brief   Hands the measurement over to the system time.
+ * @note    Must be called right after halInit().
+ */
+void bootHalReady(void) {
+
+  /* The counter is read first, a wrap right after it is still seen.*/
+  boot.hal_ticks    = TCNT2;
+  boot.hal_overflow = (TIFR2 & (1 << TOV2)) != 0;
+  boot.hal_time     = chVTGetSystemTimeX();
+  TCCR2B = 0;
+}
+
+/**
+ * @brief   Lights the boot frame.
+ * @note    The refresh engine must be initialized.
+ */
+void bootShowFirstFrame(void) {
+  display_frame_t frame;
+
+  memcpy_P(&frame, &boot_frame, sizeof(frame));
+  displayCommit(&frame);
+  displayStart();
+}
+
+/**
+ * @brief   Returns the time from reset to the first lit frame.
+ * @note    The C runtime start up before main() is not counted.
+ *
+ * @return  the boot time in us, zero if no frame is lit yet,
+ *          @p BOOT_TIME_OVERFLOW if halInit() outlasted Timer 2.
+ */
+uint32_t bootGetFirstFrameTime(void) {
+  systime_t first;
+
+  if (!displayGetFirstFrameTime(&first))
+    return 0;
+  if (boot.hal_overflow)
+    return BOOT_TIME_OVERFLOW;
+
+  return ((uint32_t)boot.hal_ticks * BOOT_TIMER_TICK_US) +
+         ST2US((systime_t)(first - boot.hal_time));
+}
+
+/**
+ * @brief   Returns the cause of the last reset.
+ *
+ * @return  the MCUSR flags saved at boot, @p WDRF set after a watchdog
+ *          reset.
+ */
+uint8_t bootGetResetCause(void) {
+
+  return boot.reset_cause;
+}
+
+/**
+ * @brief   Prints the boot time.
+ *
+ * @param[in] chp   stream to print on
+ */
+void bootReport(BaseSequentialStream *chp) {
+  static const char prefix[] PROGMEM = "boot: first frame ";
+  static const char over[] PROGMEM = "over ";
+  uint32_t us = bootGetFirstFrameTime();
+  char buf[10];
+  uint8_t i = sizeof(buf);
+
+  boot_put_P(chp, prefix);
+  if (us == BOOT_TIME_OVERFLOW) {
+    /* halInit() alone took longer.*/
+    boot_put_P(chp, over);
+    us = BOOT_TIMER_RANGE_US;
+  }
+
+  do {
+    buf[--i] = '0' + (us % 10);
+    us /= 10;
+  } while ((us > 0) && (i > 0));
+  streamWrite(chp, (const uint8_t *)&buf[i], sizeof(buf) - i);
+  streamWrite(chp, (const uint8_t *)" us\r\n", 5);
+}
@@ -0,0 +1,51 @@
+/**
+ *
+ * @file    boot.h
+ *
+ * @brief   Led cube boot sequence header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _BOOT_H_
+#define _BOOT_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Boot time of a halInit() longer than the range of Timer 2, the
+ *          time is not known.
+ */
+#define BOOT_TIME_OVERFLOW        0xFFFFFFFFUL
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void bootStart(void);
+  void bootHalReady(void);
+  void bootShowFirstFrame(void);
+  uint32_t bootGetFirstFrameTime(void);
+  uint8_t bootGetResetCause(void);
+  void bootReport(BaseSequentialStream *chp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BOOT_H_ */
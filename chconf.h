@@ -409,7 +409,7 @@
  *
  * @note    The default is @p FALSE.
  */
-#define CH_DBG_FILL_THREADS                 FALSE
+#define CH_DBG_FILL_THREADS                 TRUE
 
 /**
  * @brief   Debug option, threads profiling.
@@ -466,7 +466,8 @@
  * @details This hook is invoked just before switching between threads.
  */
 #define CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp) {                              \
-  /* Context switch code here.*/                                            \
+  /* Idle time accounting, see power.c.*/                                   \
+  powerSwitchHookI(ntp);                                                    \
 }
 
 /**
@@ -474,7 +475,8 @@
  * @details This hook is continuously invoked by the idle thread loop.
  */
 #define CH_CFG_IDLE_LOOP_HOOK() {                                           \
-  /* Idle loop code here.*/                                                 \
+  /* Sleeps until the next interrupt, see power.c.*/                        \
+  powerIdleHook();                                                          \
 }
 
 /**
@@ -495,6 +497,18 @@
   /* System halt code here.*/                                               \
 }
 
+#if !defined(_FROM_ASM_)
+struct ch_thread;
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void powerIdleHook(void);
+  void powerSwitchHookI(struct ch_thread *ntp);
+#ifdef __cplusplus
+}
+#endif
+#endif /* !defined(_FROM_ASM_) */
+
 /** @} */
 
 /*===========================================================================*/
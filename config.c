@@ -0,0 +1,284 @@
+/**
+ *
+ * @file    config.c
+ *
+ * @brief   Led cube persistent settings source file.
+ *
+ * @details Each setter applies the setting at once and wakes the settings
+ *          thread, which stores it below the animations and the serial
+ *          reader: writing the EEPROM takes a few ms per byte, up to
+ *          seconds when the store is compacted, and nobody waits for it.
+ *          The settings are applied again by @p configLoad() after a reset.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Project local files. */
+#include "display.h"
+#include "scroll.h"
+#include "store.h"
+#include "sync.h"
+#include "config.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Delay before trying again to store the settings which could not
+ *          be, while an upload is open for instance.
+ */
+#define CONFIG_RETRY_DELAY        MS2ST(500)
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Settings state.
+ */
+static struct {
+  /* Settings not stored yet, bit k is the key k.*/
+  uint8_t             dirty;
+  /* Animation played after a reset.*/
+  uint8_t             anim;
+  /* Settings thread waiting for a change.*/
+  thread_reference_t  wait;
+} config;
+
+/**
+ * @brief   Working area of the settings thread.
+ * @note    Deepest path about 139 bytes, a store compaction, plus the
+ *          interrupts above their reserve.
+ */
+static THD_WORKING_AREA(waConfig, 176);
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Marks settings to store and wakes the settings thread.
+ *
+ * @param[in] keys  bit k is the key k
+ */
+static void config_mark(uint8_t keys) {
+
+  chSysLock();
+  config.dirty |= keys;
+  chThdResumeS(&config.wait, MSG_OK);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Stores a setting.
+ *
+ * @param[in] key   setting key
+ * @return          false if the store refused it.
+ */
+static bool config_store(uint8_t key) {
+  anim_entry_t list[ANIM_PLAYLIST_SIZE];
+  char text[SCROLL_TEXT_SIZE];
+  const void *p = list;
+  uint8_t b[2];
+  systime_t period;
+  uint8_t n = 1;
+
+  switch (key) {
+  case CONFIG_KEY_BRIGHTNESS:
+    b[0] = displayGetBrightness();
+    p = b;
+    break;
+  case CONFIG_KEY_PERIOD:
+    period = displayGetLayerPeriod();
+    b[0] = (uint8_t)period;
+    b[1] = (uint8_t)(period >> 8);
+    p = b;
+    n = 2;
+    break;
+  case CONFIG_KEY_PLAYLIST:
+    n = animGetPlaylist(list) * sizeof(anim_entry_t);
+    break;
+  case CONFIG_KEY_TEXT:
+    p = text;
+    n = scrollGetText(text);
+    break;
+  case CONFIG_KEY_ANIM:
+    b[0] = config.anim;
+    p = b;
+    break;
+  default:
+    b[0] = syncGetRole();
+    p = b;
+    break;
+  }
+
+  return storeWrite(key, p, n);
+}
+
+/**
+ * @brief   Settings thread, stores the settings marked by the setters.
+ * @details The marks are cleared before the values are read, a setting
+ *          changed meanwhile is stored again.
+ */
+static THD_FUNCTION(config_thread, arg) {
+  uint8_t pending, failed, key;
+
+  (void)arg;
+  chRegSetThreadName("config");
+
+  while (true) {
+    chSysLock();
+    if (config.dirty == 0)
+      (void)chThdSuspendS(&config.wait);
+    pending = config.dirty;
+    config.dirty = 0;
+    chSysUnlock();
+
+    failed = 0;
+    for (key = CONFIG_KEY_BRIGHTNESS; key <= CONFIG_KEY_SYNC; key++) {
+      if (((pending & (1U << key)) != 0) && !config_store(key))
+        failed |= 1U << key;
+    }
+
+    if (failed != 0) {
+      chSysLock();
+      config.dirty |= failed;
+      chSysUnlock();
+      chThdSleep(CONFIG_RETRY_DELAY);
+    }
+  }
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Applies the stored settings.
+ * @note    The store must be initialized.
+ */
+void configLoad(void) {
+  anim_entry_t list[ANIM_PLAYLIST_SIZE];
+  char text[SCROLL_TEXT_SIZE];
+  uint8_t b[2];
+  int16_t n;
+
+  if (storeRead(CONFIG_KEY_BRIGHTNESS, 0, b, 1) == 1)
+    displaySetBrightness(b[0]);
+
+  if (storeRead(CONFIG_KEY_PERIOD, 0, b, 2) == 2)
+    displaySetLayerPeriod((systime_t)(b[0] | (b[1] << 8)));
+
+  n = storeRead(CONFIG_KEY_TEXT, 0, text, sizeof(text));
+  if (n > 0)
+    scrollSetText(text, n);
+
+  if (storeRead(CONFIG_KEY_ANIM, 0, b, 1) == 1) {
+    config.anim = b[0];
+    animSelect(b[0]);
+  }
+
+  n = storeRead(CONFIG_KEY_PLAYLIST, 0, list, sizeof(list));
+  if (n >= (int16_t)sizeof(anim_entry_t))
+    animSetPlaylist(list, n / sizeof(anim_entry_t));
+
+  if (storeRead(CONFIG_KEY_SYNC, 0, b, 1) == 1)
+    syncSetRole(b[0]);
+}
+
+/**
+ * @brief   Starts the settings thread.
+ * @note    The settings must be loaded first.
+ */
+void configStart(void) {
+
+  chThdCreateStatic(waConfig, sizeof(waConfig), CONFIG_STORE_PRIO,
+                    config_thread, NULL);
+}
+
+/**
+ * @brief   Sets the brightness, it is stored by the settings thread.
+ *
+ * @param[in] brightness    from 0 to 255
+ */
+void configSetBrightness(uint8_t brightness) {
+
+  displaySetBrightness(brightness);
+  config_mark(1U << CONFIG_KEY_BRIGHTNESS);
+}
+
+/**
+ * @brief   Sets the layer period, hence the refresh rate, it is stored by
+ *          the settings thread.
+ *
+ * @param[in] period    layer period in system ticks
+ */
+void configSetLayerPeriod(systime_t period) {
+
+  displaySetLayerPeriod(period);
+  config_mark(1U << CONFIG_KEY_PERIOD);
+}
+
+/**
+ * @brief   Sets the playlist, it is stored by the settings thread.
+ *
+ * @param[in] list  playlist entries
+ * @param[in] n     number of entries, zero stops the playlist
+ */
+void configSetPlaylist(const anim_entry_t *list, uint8_t n) {
+
+  animSetPlaylist(list, n);
+  config_mark(1U << CONFIG_KEY_PLAYLIST);
+}
+
+/**
+ * @brief   Sets the scrolled text, it is stored by the settings thread.
+ *
+ * @param[in] text  characters to scroll
+ * @param[in] n     number of characters
+ */
+void configSetText(const char *text, uint8_t n) {
+
+  scrollSetText(text, n);
+  config_mark(1U << CONFIG_KEY_TEXT);
+}
+
+/**
+ * @brief   Plays an animation and makes it the one played after a reset,
+ *          it is stored by the settings thread.
+ * @note    It also stops the playlist.
+ *
+ * @param[in] id    animation identifier
+ */
+void configSetAnim(uint8_t id) {
+
+  if (id >= ANIM_COUNT)
+    return;
+
+  animSelect(id);
+  config.anim = id;
+  config_mark((1U << CONFIG_KEY_ANIM) | (1U << CONFIG_KEY_PLAYLIST));
+}
+
+/**
+ * @brief   Sets the synchronization role of the cube, it is stored by the
+ *          settings thread.
+ *
+ * @param[in] role  @p SYNC_NONE, @p SYNC_MASTER or @p SYNC_FOLLOWER
+ */
+void configSetSyncRole(uint8_t role) {
+
+  if (role > SYNC_FOLLOWER)
+    return;
+
+  syncSetRole(role);
+  config_mark(1U << CONFIG_KEY_SYNC);
+}
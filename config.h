@@ -0,0 +1,76 @@
+/**
+ *
+ * @file    config.h
+ *
+ * @brief   Led cube persistent settings header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/* Project local files. */
+#include "anim.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @name    Persistent store keys
+ * @{
+ */
+#define CONFIG_KEY_BRIGHTNESS     1
+#define CONFIG_KEY_PERIOD         2
+#define CONFIG_KEY_PLAYLIST       3
+#define CONFIG_KEY_TEXT           4
+#define CONFIG_KEY_ANIM           5
+#define CONFIG_KEY_SYNC           6
+#define CONFIG_KEY_SHOW           8
+/** @} */
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Priority of the settings thread, below the animations and the
+ *          serial reader.
+ * @details Writing the EEPROM busy waits a few ms per byte, up to seconds
+ *          when the store is compacted.
+ */
+#if !defined(CONFIG_STORE_PRIO)
+#define CONFIG_STORE_PRIO         NORMALPRIO
+#endif
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void configLoad(void);
+  void configStart(void);
+  void configSetBrightness(uint8_t brightness);
+  void configSetLayerPeriod(systime_t period);
+  void configSetPlaylist(const anim_entry_t *list, uint8_t n);
+  void configSetText(const char *text, uint8_t n);
+  void configSetAnim(uint8_t id);
+  void configSetSyncRole(uint8_t role);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CONFIG_H_ */
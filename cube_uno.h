@@ -0,0 +1,48 @@
+/**
+ *
+ * @file    cube_uno.h
+ *
+ * @brief   Led cube wiring on the Arduino Uno.
+ *
+ * @details Board description read by display.h, another wiring only needs
+ *          another description, selected with @p DISPLAY_BOARD.
+ *          Each entry is X(index, port, bit), the port is B, C or D:
+ *          - columns 0..5 on D2..D7 (PD2..PD7),
+ *          - columns 6..8 on D8..D10 (PB0..PB2),
+ *          - layers  0..2 on A0..A2 (PC0..PC2), layer 0 is the bottom one.
+ *          .
+ *          Both columns and layers are active high.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _CUBE_UNO_H_
+#define _CUBE_UNO_H_
+
+/**
+ * @brief   Pin of each column, column @p DISPLAY_COLUMN(x, y) holds the
+ *          voxels (x, y, z).
+ */
+#define DISPLAY_BOARD_COLUMNS(X)                                            \
+  X(0, D, 2)                                                                \
+  X(1, D, 3)                                                                \
+  X(2, D, 4)                                                                \
+  X(3, D, 5)                                                                \
+  X(4, D, 6)                                                                \
+  X(5, D, 7)                                                                \
+  X(6, B, 0)                                                                \
+  X(7, B, 1)                                                                \
+  X(8, B, 2)
+
+/**
+ * @brief   Pin of each layer.
+ */
+#define DISPLAY_BOARD_LAYERS(X)                                             \
+  X(0, C, 0)                                                                \
+  X(1, C, 1)                                                                \
+  X(2, C, 2)
+
+#endif /* _CUBE_UNO_H_ */
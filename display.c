@@ -0,0 +1,756 @@
+/**
+ *
+ * @file    display.c
+ *
+ * @brief   Led cube frame buffer and refresh engine source file.
+ *
+ * @details The application draws into a packed column frame buffer and
+ *          commits it. Committing converts the frame into the port values
+ *          of each layer once, the refresh timer then only has to copy
+ *          precomputed bytes into the ports.
+ *          Grayscale frames are shown with binary code modulation: the lit
+ *          part of each layer is split into one slot per bit plane, each
+ *          slot twice as long as the previous one.
+ *          The conversion and the port writes are generated from the board
+ *          description at build time, they have no lookup.
+ *          Each layer period ends with a dark part, at least the dead time
+ *          long. The columns of the next layer are loaded as soon as the
+ *          lit layer is switched off, the dark part hides the switching of
+ *          the drivers.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <string.h>
+
+/* Project local files. */
+#include "display.h"
+#include "trace.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Refresh engine state.
+ */
+static struct {
+  /* Layer scan timer.*/
+  virtual_timer_t   vt;
+  /* Front and back port images of each bit plane.*/
+  display_image_t   images[2][DISPLAY_GRAY_BITS][DISPLAY_LAYERS];
+  /* Bit planes of the front and back images.*/
+  uint8_t           depth[2];
+  /* Index of the images being scanned.*/
+  uint8_t           front;
+  /* Bit plane shown on the lit layer.*/
+  uint8_t           plane;
+  /* Next layer to be lit.*/
+  uint8_t           layer;
+  /* Layer currently lit, DISPLAY_LAYERS if none.*/
+  uint8_t           lit;
+  /* A committed frame waits for the end of the current scan.*/
+  bool              pending;
+  /* A new frame waits for its first layer to be switched on.*/
+  bool              swapped;
+  /* The refresh timer owns the cube pins.*/
+  bool              active;
+  /* The lit layer is switched off at the next timer event.*/
+  bool              blank;
+  /* Time the lit layer was switched on and the current scan started.*/
+  systime_t         lit_at;
+  systime_t         scan_at;
+  /* Lit time of each layer and length of the scans, being averaged.*/
+  uint32_t          lit_sum[DISPLAY_LAYERS];
+  uint32_t          scan_sum;
+  uint8_t           scan_count;
+  /* Brightness and layer period, set by the application.*/
+  uint8_t           brightness;
+  systime_t         period;
+  /* Lit and dark parts of the layer period, in ticks.*/
+  systime_t         on;
+  systime_t         off;
+  /* Slot of each bit plane in the lit part, in ticks.*/
+  systime_t         slot[DISPLAY_GRAY_BITS];
+  /* Time the first committed frame was shown.*/
+  systime_t         first;
+  bool              shown;
+  /* Last committed frame and its number of bit planes.*/
+  display_gray_t    last;
+  uint8_t           last_depth;
+  /* Layers of the images not holding the last frame which differ from it.*/
+  uint8_t           stale;
+  /* Time the scan timer is due.*/
+  systime_t         due;
+  /* Deadline statistics.*/
+  display_stats_t   stats;
+} display;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Converts a layer of a frame into its port values.
+ *
+ * @param[out] ip   pointer to the layer image
+ * @param[in] fp    pointer to the frame
+ * @param[in] z     layer
+ */
+static void display_render_layer(display_image_t *ip,
+                                 const display_frame_t *fp, uint8_t z) {
+  uint8_t mask = 1U << z;
+
+  memset(ip, 0, sizeof(*ip));
+#define DISPLAY_RENDER(c, port, bit)                                        \
+  if (fp->col[c] & mask)                                                    \
+    ip->out[DISPLAY_PORT_##port] |= 1U << (bit);
+  DISPLAY_BOARD_COLUMNS(DISPLAY_RENDER)
+#undef DISPLAY_RENDER
+}
+
+/**
+ * @brief   Converts a frame into the port values of each layer.
+ *
+ * @param[out] ip   pointer to the layer images
+ * @param[in] fp    pointer to the frame
+ */
+static void display_render(display_image_t *ip, const display_frame_t *fp) {
+  uint8_t z;
+
+  for (z = 0; z < DISPLAY_LAYERS; z++)
+    display_render_layer(&ip[z], fp, z);
+}
+
+/**
+ * @brief   Writes the columns of a layer, the layers are left as they are.
+ *
+ * @param[in] ip    pointer to the layer image
+ */
+static inline void display_write_columns(const display_image_t *ip) {
+
+  if (DISPLAY_COLUMNS_MASK_B != 0)
+    PORTB = (PORTB & ~DISPLAY_COLUMNS_MASK_B) | ip->out[DISPLAY_PORT_B];
+  if (DISPLAY_COLUMNS_MASK_C != 0)
+    PORTC = (PORTC & ~DISPLAY_COLUMNS_MASK_C) | ip->out[DISPLAY_PORT_C];
+  if (DISPLAY_COLUMNS_MASK_D != 0)
+    PORTD = (PORTD & ~DISPLAY_COLUMNS_MASK_D) | ip->out[DISPLAY_PORT_D];
+}
+
+/**
+ * @brief   Switches all the layers off.
+ */
+static inline void display_blank_layers(void) {
+
+  if (DISPLAY_LAYERS_MASK_B != 0)
+    PORTB &= ~DISPLAY_LAYERS_MASK_B;
+  if (DISPLAY_LAYERS_MASK_C != 0)
+    PORTC &= ~DISPLAY_LAYERS_MASK_C;
+  if (DISPLAY_LAYERS_MASK_D != 0)
+    PORTD &= ~DISPLAY_LAYERS_MASK_D;
+}
+
+/**
+ * @brief   Switches a layer on.
+ *
+ * @param[in] z     layer to switch on
+ */
+static inline void display_light_layer(uint8_t z) {
+
+#define DISPLAY_LIGHT(i, port, bit)                                         \
+  if (z == (i))                                                             \
+    PORT##port |= 1U << (bit);
+  DISPLAY_BOARD_LAYERS(DISPLAY_LIGHT)
+#undef DISPLAY_LIGHT
+}
+
+/**
+ * @brief   Splits the layer period between lit and dark time.
+ * @note    The lit part is at least @p CH_CFG_ST_TIMEDELTA long, the dark
+ *          part at least the dead time. Without dead time a dark part
+ *          shorter than @p CH_CFG_ST_TIMEDELTA is dropped, the layer then
+ *          stays lit during the whole period.
+ */
+static void display_update_timing(void) {
+  systime_t on, slot[DISPLAY_GRAY_BITS];
+  uint8_t b;
+
+  on = (systime_t)(((uint32_t)display.period * (display.brightness + 1U)) >> 8);
+  if (on < CH_CFG_ST_TIMEDELTA)
+    on = CH_CFG_ST_TIMEDELTA;
+  if ((display.period - on) < DISPLAY_DEAD_TIME)
+    on = display.period - DISPLAY_DEAD_TIME;
+  if ((display.period - on) < CH_CFG_ST_TIMEDELTA)
+    on = display.period;
+
+  /* The slots of the dimmest planes are stretched to the shortest delay,
+     the lit part then grows a bit.*/
+  for (b = 0; b < DISPLAY_GRAY_BITS; b++) {
+    slot[b] = (systime_t)(((uint32_t)on << b) / DISPLAY_GRAY_MAX);
+    if (slot[b] < CH_CFG_ST_TIMEDELTA)
+      slot[b] = CH_CFG_ST_TIMEDELTA;
+  }
+
+  chSysLock();
+  display.on  = on;
+  display.off = display.period - on;
+  memcpy(display.slot, slot, sizeof(slot));
+  chSysUnlock();
+}
+
+static void display_refresh_cb(void *arg);
+
+/**
+ * @brief   Arms the scan timer and notes when it is due.
+ *
+ * @param[in] delay     time until the next timer event
+ */
+static void display_arm_i(systime_t delay) {
+
+  display.due = chVTGetSystemTimeX() + delay;
+  chVTSetI(&display.vt, delay, display_refresh_cb, NULL);
+}
+
+/**
+ * @brief   Checks that the scan timer fired in time.
+ * @details A layer lit late stays lit longer than the others, it shows as
+ *          a flicker, the event is counted as a missed deadline.
+ */
+static void display_check_deadline_i(void) {
+  int16_t late = (int16_t)(chVTGetSystemTimeX() - display.due);
+
+  if (late > (int16_t)display.stats.worst)
+    display.stats.worst = (systime_t)late;
+  if (late > DISPLAY_LATE_LIMIT)
+    display.stats.missed++;
+}
+
+/**
+ * @brief   Accounts the time the lit layer stayed on.
+ * @details The times are averaged over @p DISPLAY_DUTY_SCANS scans, the
+ *          averages are published in the statistics.
+ *
+ * @param[in] now   current system time
+ */
+static void display_measure_i(systime_t now) {
+  uint8_t z;
+
+  if (display.lit < DISPLAY_LAYERS)
+    display.lit_sum[display.lit] += now - display.lit_at;
+  display.lit = DISPLAY_LAYERS;
+
+  /* A scan ends when the first layer is loaded again.*/
+  if (display.layer != 0)
+    return;
+
+  display.scan_sum += now - display.scan_at;
+  display.scan_at = now;
+  if (++display.scan_count < DISPLAY_DUTY_SCANS)
+    return;
+
+  for (z = 0; z < DISPLAY_LAYERS; z++) {
+    display.stats.lit[z] = (uint16_t)(display.lit_sum[z] / DISPLAY_DUTY_SCANS);
+    display.lit_sum[z] = 0;
+  }
+  display.stats.scan = (uint16_t)(display.scan_sum / DISPLAY_DUTY_SCANS);
+  display.scan_sum = 0;
+  display.scan_count = 0;
+}
+
+/**
+ * @brief   Loads the columns of the next layer, its layer stays off.
+ */
+static void display_load_i(void) {
+  const display_image_t *ip;
+
+  if (display.layer == 0)
+    display.stats.scans++;
+
+  /* New frames are only swapped in between two scans, no tearing.*/
+  if ((display.layer == 0) && display.pending) {
+    display.front ^= 1;
+    display.pending = false;
+    display.swapped = true;
+  }
+
+  ip = &display.images[display.front][0][display.layer];
+  display_write_columns(ip);
+}
+
+/**
+ * @brief   Switches the lit layer off or the loaded layer on, then rearms
+ *          the scan timer.
+ * @details The timer fires twice per layer: at the end of the lit part the
+ *          layer is switched off and the next columns are loaded, at the
+ *          end of the dark part the next layer is switched on. Without dark
+ *          part both happen in the same event. A grayscale frame also
+ *          fires at the end of each bit plane slot but the last one, the
+ *          columns of the next plane are then loaded.
+ *
+ * @param[in] now   current system time
+ */
+static void display_scan_i(systime_t now) {
+
+  if (display.blank) {
+    if (++display.plane < display.depth[display.front]) {
+      display_write_columns(
+          &display.images[display.front][display.plane][display.lit]);
+#if TRACE_ENABLE == TRUE
+      traceLayerI((display.plane << 4) | display.lit,
+                  &display.images[display.front][display.plane][display.lit]);
+#endif
+      display_arm_i(display.slot[display.plane]);
+      return;
+    }
+
+    display_blank_layers();
+    display_measure_i(now);
+    display_load_i();
+#if TRACE_ENABLE == TRUE
+    traceLayerI(TRACE_LAYERS_OFF,
+                &display.images[display.front][0][display.layer]);
+#endif
+    display.blank = false;
+    if (display.off > 0) {
+      display_arm_i(display.off);
+      return;
+    }
+  }
+
+  display_light_layer(display.layer);
+  display.lit    = display.layer;
+  display.lit_at = now;
+
+  /* A frame is shown once its first layer is on, after the dead time.*/
+  if (display.swapped) {
+    display.swapped = false;
+    if (!display.shown) {
+      display.first = now;
+      display.shown = true;
+    }
+#if TRACE_ENABLE == TRUE
+    traceShowI(display.depth[display.front]);
+#endif
+  }
+#if TRACE_ENABLE == TRUE
+  traceLayerI(display.layer, &display.images[display.front][0][display.layer]);
+#endif
+
+  if (++display.layer >= DISPLAY_LAYERS)
+    display.layer = 0;
+
+  display.plane = 0;
+  display.blank = true;
+  display_arm_i((display.depth[display.front] > 1) ? display.slot[0] :
+                                                     display.on);
+}
+
+/**
+ * @brief   Scan timer callback.
+ * @details Timer 2 runs at F_CPU / 8, the duration of the longest event is
+ *          kept in the statistics.
+ *
+ * @param[in] arg   unused
+ */
+static void display_refresh_cb(void *arg) {
+  uint8_t start = TCNT2;
+  uint8_t time;
+
+  (void)arg;
+
+  chSysLockFromISR();
+  display_check_deadline_i();
+  display_scan_i(chVTGetSystemTimeX());
+  time = TCNT2 - start;
+  if (time > display.stats.isr_max)
+    display.stats.isr_max = time;
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Commits the bit planes of a frame.
+ * @note    A frame identical to the last committed one is ignored, static
+ *          content costs neither a render nor a swap.
+ *
+ * @param[in] fp        pointer to the bit planes
+ * @param[in] depth     number of bit planes
+ */
+static void display_commit(const display_frame_t *fp, uint8_t depth) {
+  uint8_t back, b;
+
+  if ((depth == display.last_depth) &&
+      (memcmp(fp, display.last.plane, depth * sizeof(*fp)) == 0)) {
+    chSysLock();
+    display.stats.unchanged++;
+    chSysUnlock();
+    return;
+  }
+  memcpy(display.last.plane, fp, depth * sizeof(*fp));
+  display.last_depth = depth;
+
+  /* Cancels a swap still pending so the back images can be rewritten.*/
+  chSysLock();
+  display.pending = false;
+  back = display.front ^ 1;
+  chSysUnlock();
+
+  for (b = 0; b < depth; b++)
+    display_render(display.images[back][b], &fp[b]);
+  display.stale = (1U << DISPLAY_LAYERS) - 1U;
+#if TRACE_ENABLE == TRUE
+  traceCommit(fp, depth);
+#endif
+
+  chSysLock();
+  display.depth[back] = depth;
+  display.pending = true;
+  chSysUnlock();
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Initializes the refresh engine with a blank frame.
+ */
+void displayInit(void) {
+
+  chVTObjectInit(&display.vt);
+  memset(display.images, 0, sizeof(display.images));
+  memset(&display.last, 0, sizeof(display.last));
+  display.depth[0] = 1;
+  display.depth[1] = 1;
+  display.last_depth = 1;
+  display.stale   = 0;
+  display.plane   = DISPLAY_GRAY_BITS;
+  display.front   = 0;
+  display.layer   = 0;
+  display.pending = false;
+  display.swapped = false;
+  display.active  = false;
+  display.blank   = true;
+  display.lit     = DISPLAY_LAYERS;
+  display.shown   = false;
+  memset(&display.stats, 0, sizeof(display.stats));
+  display.brightness = DISPLAY_BRIGHTNESS;
+  display.period  = DISPLAY_LAYER_PERIOD;
+  display_update_timing();
+
+  /* Timer 2 times the scan timer events, free running.*/
+  TCCR2A = 0;
+  TCCR2B = (1 << CS21);
+}
+
+/**
+ * @brief   Takes the cube pins and starts scanning the layers.
+ */
+void displayStart(void) {
+
+  DDRB  |= DISPLAY_COLUMNS_MASK_B | DISPLAY_LAYERS_MASK_B;
+  DDRC  |= DISPLAY_COLUMNS_MASK_C | DISPLAY_LAYERS_MASK_C;
+  DDRD  |= DISPLAY_COLUMNS_MASK_D | DISPLAY_LAYERS_MASK_D;
+
+  chSysLock();
+  if (!display.active) {
+    display.layer  = 0;
+    display.lit    = DISPLAY_LAYERS;
+    display.plane  = DISPLAY_GRAY_BITS;
+    display.active = true;
+    display.blank  = true;
+    /* The duty cycle averages start over.*/
+    memset(display.lit_sum, 0, sizeof(display.lit_sum));
+    display.scan_sum   = 0;
+    display.scan_count = 0;
+    display.scan_at    = chVTGetSystemTimeX();
+    /* The first layer is lit as soon as possible.*/
+    display_arm_i(CH_CFG_ST_TIMEDELTA);
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Stops scanning and switches all the layers off.
+ */
+void displayStop(void) {
+
+  chSysLock();
+  if (display.active) {
+    chVTResetI(&display.vt);
+    display.active = false;
+  }
+  display_blank_layers();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Restarts the scan from the first layer.
+ * @details Used to align the scans of synchronized cubes.
+ */
+void displayResync(void) {
+
+  chSysLock();
+  if (display.active) {
+    chVTResetI(&display.vt);
+    display_blank_layers();
+    display_measure_i(chVTGetSystemTimeX());
+    display.layer = 0;
+    display.plane = DISPLAY_GRAY_BITS;
+    display.blank = true;
+    display_arm_i(CH_CFG_ST_TIMEDELTA);
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Tells if the refresh engine currently drives the cube.
+ *
+ * @return  true when the layers are being scanned.
+ */
+bool displayIsActive(void) {
+
+  return display.active;
+}
+
+/**
+ * @brief   Commits a frame, it is displayed from the next scan on.
+ *
+ * @param[in] fp    pointer to the frame to display
+ */
+void displayCommit(const display_frame_t *fp) {
+
+  display_commit(fp, 1);
+}
+
+/**
+ * @brief   Commits a grayscale frame, it is displayed from the next scan on.
+ *
+ * @param[in] gp    pointer to the frame to display
+ */
+void displayCommitGray(const display_gray_t *gp) {
+
+  display_commit(gp->plane, DISPLAY_GRAY_BITS);
+}
+
+/**
+ * @brief   Commits a grayscale frame differing from the last committed one
+ *          only by some voxels, it is displayed from the next scan on.
+ * @details The frame is copied but not compared, only the layers holding
+ *          the listed voxels are converted, with the layers the back images
+ *          missed from the previous frame: the conversion depends on the
+ *          changes and not on the size of the cube. A frame listing no
+ *          voxel is counted as unchanged, a frame following a frame of
+ *          another depth is committed whole.
+ * @note    The voxels not listed must be the same as in the last committed
+ *          frame, a frame drawn from scratch goes through
+ *          displayCommitGray().
+ *
+ * @param[in] gp        pointer to the frame to display
+ * @param[in] voxels    voxels which changed, c * DISPLAY_LAYERS + z
+ * @param[in] n         number of voxels
+ */
+void displayCommitVoxels(const display_gray_t *gp, const uint8_t *voxels,
+                         uint8_t n) {
+  uint8_t layers = 0, stale, back, z, b;
+  bool pending;
+
+  if (display.last_depth != DISPLAY_GRAY_BITS) {
+    display_commit(gp->plane, DISPLAY_GRAY_BITS);
+    return;
+  }
+
+  if (n == 0) {
+    chSysLock();
+    display.stats.unchanged++;
+    chSysUnlock();
+    return;
+  }
+
+  while (n > 0)
+    layers |= 1U << (voxels[--n] % DISPLAY_LAYERS);
+  memcpy(&display.last, gp, sizeof(display.last));
+
+  /* Cancels a swap still pending so the back images can be rewritten.*/
+  chSysLock();
+  pending = display.pending;
+  display.pending = false;
+  back = display.front ^ 1;
+  chSysUnlock();
+
+  /* Once swapped the back images miss the layers of the previous frame.*/
+  stale = pending ? 0 : (display.stale & ~layers);
+  for (z = 0; z < DISPLAY_LAYERS; z++) {
+    for (b = 0; b < DISPLAY_GRAY_BITS; b++) {
+      if (stale & (1U << z))
+        display.images[back][b][z] = display.images[display.front][b][z];
+      else if (layers & (1U << z))
+        display_render_layer(&display.images[back][b][z],
+                             &display.last.plane[b], z);
+    }
+  }
+  display.stale = pending ? (display.stale | layers) : layers;
+#if TRACE_ENABLE == TRUE
+  traceCommit(display.last.plane, DISPLAY_GRAY_BITS);
+#endif
+
+  chSysLock();
+  display.depth[back] = DISPLAY_GRAY_BITS;
+  display.pending = true;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the time the first committed frame was shown.
+ *
+ * @param[out] timep    system time of the first frame
+ * @return              false if no frame has been shown yet.
+ */
+bool displayGetFirstFrameTime(systime_t *timep) {
+  bool shown;
+
+  chSysLock();
+  shown = display.shown;
+  *timep = display.first;
+  chSysUnlock();
+
+  return shown;
+}
+
+/**
+ * @brief   Returns the deadline statistics of the refresh.
+ *
+ * @param[out] sp   statistics
+ *
+ * @iclass
+ */
+void displayGetStatsI(display_stats_t *sp) {
+
+  *sp = display.stats;
+}
+
+/**
+ * @brief   Returns the duty cycle each layer gets.
+ * @details Measured from the actual timer events, the lateness of the timer
+ *          and the dead time are accounted for.
+ *
+ * @param[out] duty     lit time of each layer, in percent of the scan
+ */
+void displayGetDuty(uint8_t *duty) {
+  display_stats_t stats;
+  uint8_t z;
+
+  chSysLock();
+  displayGetStatsI(&stats);
+  chSysUnlock();
+
+  for (z = 0; z < DISPLAY_LAYERS; z++)
+    duty[z] = (stats.scan > 0) ?
+              (uint8_t)(((uint32_t)stats.lit[z] * 100U) / stats.scan) : 0;
+}
+
+/**
+ * @brief   Sets the brightness of the cube.
+ *
+ * @param[in] brightness    from 0 (dimmest) to 255 (layers lit during the
+ *                          whole period but the dead time)
+ */
+void displaySetBrightness(uint8_t brightness) {
+
+  display.brightness = brightness;
+  display_update_timing();
+}
+
+/**
+ * @brief   Returns the brightness of the cube.
+ *
+ * @return  the brightness.
+ */
+uint8_t displayGetBrightness(void) {
+
+  return display.brightness;
+}
+
+/**
+ * @brief   Sets the time each layer is scanned, hence the refresh rate.
+ *
+ * @param[in] period    layer period in system ticks
+ */
+void displaySetLayerPeriod(systime_t period) {
+
+  if (period < DISPLAY_MIN_PERIOD)
+    period = DISPLAY_MIN_PERIOD;
+
+  display.period = period;
+  display_update_timing();
+}
+
+/**
+ * @brief   Returns the time each layer is scanned.
+ *
+ * @return  the layer period in system ticks.
+ */
+systime_t displayGetLayerPeriod(void) {
+
+  return display.period;
+}
+
+/**
+ * @brief   Switches off all the voxels of a frame.
+ *
+ * @param[out] fp   pointer to the frame to clear
+ */
+void displayClear(display_frame_t *fp) {
+
+  memset(fp, 0, sizeof(*fp));
+}
+
+/**
+ * @brief   Sets a whole layer of a frame at once.
+ *
+ * @param[out] fp   pointer to the frame
+ * @param[in] z     layer to set
+ * @param[in] mask  voxels to switch on, bit @p DISPLAY_COLUMN(x, y) is the
+ *                  voxel (x, y, z)
+ */
+void displaySetLayer(display_frame_t *fp, uint8_t z, uint16_t mask) {
+  uint8_t bit = 1U << z;
+  uint8_t c;
+
+  for (c = 0; c < DISPLAY_COLUMNS; c++) {
+    if (mask & 1)
+      fp->col[c] |= bit;
+    else
+      fp->col[c] &= ~bit;
+    mask >>= 1;
+  }
+}
+
+/**
+ * @brief   Sets the level of a voxel of a grayscale frame.
+ *
+ * @param[out] gp   pointer to the frame
+ * @param[in] c     column of the voxel, @p DISPLAY_COLUMN(x, y)
+ * @param[in] z     layer of the voxel
+ * @param[in] level from 0 (off) to @p DISPLAY_GRAY_MAX
+ */
+void displaySetLevel(display_gray_t *gp, uint8_t c, uint8_t z,
+                     uint8_t level) {
+  uint8_t bit = 1U << z;
+  uint8_t b;
+
+  for (b = 0; b < DISPLAY_GRAY_BITS; b++) {
+    if (level & 1)
+      gp->plane[b].col[c] |= bit;
+    else
+      gp->plane[b].col[c] &= ~bit;
+    level >>= 1;
+  }
+}
@@ -0,0 +1,296 @@
+/**
+ *
+ * @file    display.h
+ *
+ * @brief   Led cube frame buffer and refresh engine header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _DISPLAY_H_
+#define _DISPLAY_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Number of voxels along one edge of the cube.
+ */
+#define DISPLAY_SIZE              3
+
+/**
+ * @brief   Number of vertical columns of the cube.
+ */
+#define DISPLAY_COLUMNS           (DISPLAY_SIZE * DISPLAY_SIZE)
+
+/**
+ * @brief   Number of multiplexed layers of the cube.
+ */
+#define DISPLAY_LAYERS            DISPLAY_SIZE
+
+/**
+ * @brief   Number of voxels of the cube.
+ */
+#define DISPLAY_VOXELS            (DISPLAY_COLUMNS * DISPLAY_LAYERS)
+
+/**
+ * @brief   Column index of the voxel at (x, y).
+ */
+#define DISPLAY_COLUMN(x, y)      ((x) + ((y) * DISPLAY_SIZE))
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Default time each layer is scanned, in system ticks.
+ */
+#if !defined(DISPLAY_LAYER_PERIOD)
+#define DISPLAY_LAYER_PERIOD      US2ST(2000)
+#endif
+
+/**
+ * @brief   Default brightness, from 0 to 255.
+ */
+#if !defined(DISPLAY_BRIGHTNESS)
+#define DISPLAY_BRIGHTNESS        255
+#endif
+
+/**
+ * @brief   Number of bit planes of a grayscale frame, from 1 to 4.
+ */
+#if !defined(DISPLAY_GRAY_BITS)
+#define DISPLAY_GRAY_BITS         3
+#endif
+
+/**
+ * @brief   Time all the layers are off between two layers, in system ticks.
+ * @details The columns of the next layer are loaded at the start of the
+ *          dead time, the drivers of the previous layer have the whole dead
+ *          time to switch off: no ghosting.
+ * @note    Zero or at least @p CH_CFG_ST_TIMEDELTA.
+ */
+#if !defined(DISPLAY_DEAD_TIME)
+#define DISPLAY_DEAD_TIME         CH_CFG_ST_TIMEDELTA
+#endif
+
+/**
+ * @brief   Number of scans the duty cycle is averaged on, a power of two.
+ */
+#if !defined(DISPLAY_DUTY_SCANS)
+#define DISPLAY_DUTY_SCANS        16
+#endif
+
+/**
+ * @brief   Lateness of the scan timer counted as a missed deadline, in
+ *          system ticks.
+ */
+#if !defined(DISPLAY_LATE_LIMIT)
+#define DISPLAY_LATE_LIMIT        2
+#endif
+
+/**
+ * @brief   Board description, the wiring of the cube.
+ */
+#if !defined(DISPLAY_BOARD)
+#define DISPLAY_BOARD             "cube_uno.h"
+#endif
+
+/*==========================================================================*/
+/* Derived constants and error checks.                                      */
+/*==========================================================================*/
+
+#include DISPLAY_BOARD
+
+/**
+ * @name    Ports of the board description
+ * @{
+ */
+#define DISPLAY_PORT_B            0
+#define DISPLAY_PORT_C            1
+#define DISPLAY_PORT_D            2
+#define DISPLAY_PORTS             3
+/** @} */
+
+/* Bit of a pin of the board description if it is on the port p.*/
+#define DISPLAY_PIN(p, port, bit)                                           \
+  ((DISPLAY_PORT_##port == DISPLAY_PORT_##p) ? (1U << (bit)) : 0U)
+
+/* Entries of the board description merged into masks, or added to detect
+   the pins used twice.*/
+#define DISPLAY_OR_B(i, port, bit)      | DISPLAY_PIN(B, port, bit)
+#define DISPLAY_OR_C(i, port, bit)      | DISPLAY_PIN(C, port, bit)
+#define DISPLAY_OR_D(i, port, bit)      | DISPLAY_PIN(D, port, bit)
+#define DISPLAY_ADD_B(i, port, bit)     + DISPLAY_PIN(B, port, bit)
+#define DISPLAY_ADD_C(i, port, bit)     + DISPLAY_PIN(C, port, bit)
+#define DISPLAY_ADD_D(i, port, bit)     + DISPLAY_PIN(D, port, bit)
+#define DISPLAY_OR_INDEX(i, port, bit)  | (1UL << (i))
+#define DISPLAY_ADD_INDEX(i, port, bit) + (1UL << (i))
+
+/**
+ * @name    Pins of the columns and of the layers on each port
+ * @{
+ */
+#define DISPLAY_COLUMNS_MASK_B    (0U DISPLAY_BOARD_COLUMNS(DISPLAY_OR_B))
+#define DISPLAY_COLUMNS_MASK_C    (0U DISPLAY_BOARD_COLUMNS(DISPLAY_OR_C))
+#define DISPLAY_COLUMNS_MASK_D    (0U DISPLAY_BOARD_COLUMNS(DISPLAY_OR_D))
+#define DISPLAY_LAYERS_MASK_B     (0U DISPLAY_BOARD_LAYERS(DISPLAY_OR_B))
+#define DISPLAY_LAYERS_MASK_C     (0U DISPLAY_BOARD_LAYERS(DISPLAY_OR_C))
+#define DISPLAY_LAYERS_MASK_D     (0U DISPLAY_BOARD_LAYERS(DISPLAY_OR_D))
+/** @} */
+
+/* All the pins of the cube on a port, merged or added.*/
+#define DISPLAY_PINS_OR(p)                                                  \
+  (0U DISPLAY_BOARD_COLUMNS(DISPLAY_OR_##p)                                 \
+      DISPLAY_BOARD_LAYERS(DISPLAY_OR_##p))
+#define DISPLAY_PINS_ADD(p)                                                 \
+  (0U DISPLAY_BOARD_COLUMNS(DISPLAY_ADD_##p)                                \
+      DISPLAY_BOARD_LAYERS(DISPLAY_ADD_##p))
+
+#if ((0UL DISPLAY_BOARD_COLUMNS(DISPLAY_OR_INDEX)) !=                       \
+     ((1UL << DISPLAY_COLUMNS) - 1)) ||                                     \
+    ((0UL DISPLAY_BOARD_COLUMNS(DISPLAY_ADD_INDEX)) !=                      \
+     ((1UL << DISPLAY_COLUMNS) - 1))
+#error "DISPLAY_BOARD must describe each column exactly once"
+#endif
+
+#if ((0UL DISPLAY_BOARD_LAYERS(DISPLAY_OR_INDEX)) !=                        \
+     ((1UL << DISPLAY_LAYERS) - 1)) ||                                      \
+    ((0UL DISPLAY_BOARD_LAYERS(DISPLAY_ADD_INDEX)) !=                       \
+     ((1UL << DISPLAY_LAYERS) - 1))
+#error "DISPLAY_BOARD must describe each layer exactly once"
+#endif
+
+#if (DISPLAY_PINS_OR(B) > 0xFF) || (DISPLAY_PINS_OR(C) > 0xFF) ||           \
+    (DISPLAY_PINS_OR(D) > 0xFF)
+#error "DISPLAY_BOARD uses a pin above bit 7"
+#endif
+
+#if (DISPLAY_PINS_OR(B) != DISPLAY_PINS_ADD(B)) ||                          \
+    (DISPLAY_PINS_OR(C) != DISPLAY_PINS_ADD(C)) ||                          \
+    (DISPLAY_PINS_OR(D) != DISPLAY_PINS_ADD(D))
+#error "DISPLAY_BOARD uses a pin twice"
+#endif
+
+#if (DISPLAY_PINS_OR(D) & 0x03) != 0
+#error "DISPLAY_BOARD uses PD0 or PD1, the pins of the serial port"
+#endif
+
+#if (DISPLAY_DEAD_TIME > 0) && (DISPLAY_DEAD_TIME < CH_CFG_ST_TIMEDELTA)
+#error "DISPLAY_DEAD_TIME must be zero or at least CH_CFG_ST_TIMEDELTA"
+#endif
+
+#if (DISPLAY_GRAY_BITS < 1) || (DISPLAY_GRAY_BITS > 4)
+#error "DISPLAY_GRAY_BITS must be between 1 and 4"
+#endif
+
+/**
+ * @brief   Brightest level of a grayscale voxel.
+ */
+#define DISPLAY_GRAY_MAX          ((1U << DISPLAY_GRAY_BITS) - 1)
+
+#if (DISPLAY_DUTY_SCANS & (DISPLAY_DUTY_SCANS - 1)) != 0
+#error "DISPLAY_DUTY_SCANS must be a power of two"
+#endif
+
+/**
+ * @brief   Shortest layer period, the lit and dark parts both fit in.
+ */
+#if DISPLAY_DEAD_TIME > CH_CFG_ST_TIMEDELTA
+#define DISPLAY_MIN_PERIOD        (DISPLAY_DEAD_TIME + CH_CFG_ST_TIMEDELTA)
+#else
+#define DISPLAY_MIN_PERIOD        (2 * CH_CFG_ST_TIMEDELTA)
+#endif
+
+/*==========================================================================*/
+/* Data structures and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Packed frame buffer.
+ * @details Each byte is one vertical column of the cube, bit @p z of
+ *          @p col[DISPLAY_COLUMN(x, y)] is the voxel (x, y, z).
+ */
+typedef struct {
+  uint8_t col[DISPLAY_COLUMNS];
+} display_frame_t;
+
+/**
+ * @brief   Grayscale frame buffer.
+ * @details Bit plane @p b holds bit @p b of the level of each voxel, the
+ *          voxels are lit during a time proportional to their level.
+ */
+typedef struct {
+  display_frame_t plane[DISPLAY_GRAY_BITS];
+} display_gray_t;
+
+/**
+ * @brief   Column pins of each port driving one layer.
+ */
+typedef struct {
+  uint8_t out[DISPLAY_PORTS];
+} display_image_t;
+
+/**
+ * @brief   Refresh deadline statistics.
+ */
+typedef struct {
+  /* Scans started.*/
+  uint16_t  scans;
+  /* Timer events later than @p DISPLAY_LATE_LIMIT.*/
+  uint16_t  missed;
+  /* Worst lateness of the timer.*/
+  systime_t worst;
+  /* Committed frames identical to the previous one.*/
+  uint16_t  unchanged;
+  /* Longest scan timer event, in F_CPU / 8 cycles.*/
+  uint8_t   isr_max;
+  /* Average lit time of each layer and length of a scan, in ticks.*/
+  uint16_t  lit[DISPLAY_LAYERS];
+  uint16_t  scan;
+} display_stats_t;
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void displayInit(void);
+  void displayStart(void);
+  void displayStop(void);
+  void displayResync(void);
+  bool displayIsActive(void);
+  void displayCommit(const display_frame_t *fp);
+  void displayCommitGray(const display_gray_t *gp);
+  void displayCommitVoxels(const display_gray_t *gp, const uint8_t *voxels,
+                           uint8_t n);
+  bool displayGetFirstFrameTime(systime_t *timep);
+  void displayGetStatsI(display_stats_t *sp);
+  void displayGetDuty(uint8_t *duty);
+  void displaySetBrightness(uint8_t brightness);
+  uint8_t displayGetBrightness(void);
+  void displaySetLayerPeriod(systime_t period);
+  systime_t displayGetLayerPeriod(void);
+  void displayClear(display_frame_t *fp);
+  void displaySetLayer(display_frame_t *fp, uint8_t z, uint16_t mask);
+  void displaySetLevel(display_gray_t *gp, uint8_t c, uint8_t z,
+                       uint8_t level);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DISPLAY_H_ */
@@ -0,0 +1,124 @@
+/**
+ *
+ * @file    effects.c
+ *
+ * @brief   Led cube random effects source file.
+ *
+ * @details Only one effect runs at a time, they share the same frame and
+ *          random stream. The stream is reseeded each time an effect is
+ *          started, so an effect always plays the same sequence.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Project local files. */
+#include "display.h"
+#include "effects.h"
+#include "prng.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Effects state.
+ */
+static struct {
+  /* Frame drawn by the running effect.*/
+  display_frame_t   frame;
+  /* Random stream of the running effect.*/
+  prng_t            rng;
+  /* Voxels switched on by the random fill.*/
+  uint8_t           count;
+  /* The random fill is emptying the cube.*/
+  bool              emptying;
+} effects;
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Clears the cube and reseeds the random stream of the effects.
+ *
+ * @param[in] stream    random stream of the effect being started
+ */
+void effectsStart(uint8_t stream) {
+
+  displayClear(&effects.frame);
+  prngSeedStream(&effects.rng, stream);
+  effects.count    = 0;
+  effects.emptying = false;
+}
+
+/**
+ * @brief   Sparkle, about a quarter of the voxels randomly lit.
+ *
+ * @return  time until the next frame.
+ */
+systime_t effectsSparkleStep(void) {
+  uint8_t z;
+
+  for (z = 0; z < DISPLAY_LAYERS; z++)
+    displaySetLayer(&effects.frame, z, prngMask(&effects.rng, 2));
+
+  displayCommit(&effects.frame);
+
+  return EFFECTS_SPARKLE_PERIOD;
+}
+
+/**
+ * @brief   Rain, drops appear on the top layer and fall down.
+ *
+ * @return  time until the next frame.
+ */
+systime_t effectsRainStep(void) {
+  uint16_t drops = prngMask(&effects.rng, 2);
+  uint8_t c;
+
+  for (c = 0; c < DISPLAY_COLUMNS; c++) {
+    effects.frame.col[c] >>= 1;
+    if (drops & 1)
+      effects.frame.col[c] |= 1U << (DISPLAY_LAYERS - 1);
+    drops >>= 1;
+  }
+
+  displayCommit(&effects.frame);
+
+  return EFFECTS_RAIN_PERIOD;
+}
+
+/**
+ * @brief   Random fill, lights the voxels one by one in a random order then
+ *          switches them off the same way.
+ *
+ * @return  time until the next frame.
+ */
+systime_t effectsFillStep(void) {
+  uint8_t v = prngRange(&effects.rng, DISPLAY_VOXELS);
+  uint8_t lit = effects.emptying ? 1 : 0;
+
+  /* Looks for the next voxel still to be toggled.*/
+  while (((effects.frame.col[v % DISPLAY_COLUMNS] >>
+           (v / DISPLAY_COLUMNS)) & 1) != lit) {
+    if (++v >= DISPLAY_VOXELS)
+      v = 0;
+  }
+  effects.frame.col[v % DISPLAY_COLUMNS] ^= 1U << (v / DISPLAY_COLUMNS);
+
+  if (++effects.count >= DISPLAY_VOXELS) {
+    effects.count    = 0;
+    effects.emptying = !effects.emptying;
+  }
+
+  displayCommit(&effects.frame);
+
+  return EFFECTS_FILL_PERIOD;
+}
@@ -0,0 +1,63 @@
+/**
+ *
+ * @file    effects.h
+ *
+ * @brief   Led cube random effects header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _EFFECTS_H_
+#define _EFFECTS_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Time between two sparkle frames, in system ticks.
+ */
+#if !defined(EFFECTS_SPARKLE_PERIOD)
+#define EFFECTS_SPARKLE_PERIOD    MS2ST(80)
+#endif
+
+/**
+ * @brief   Time between two rain frames, in system ticks.
+ */
+#if !defined(EFFECTS_RAIN_PERIOD)
+#define EFFECTS_RAIN_PERIOD       MS2ST(120)
+#endif
+
+/**
+ * @brief   Time between two random fill frames, in system ticks.
+ */
+#if !defined(EFFECTS_FILL_PERIOD)
+#define EFFECTS_FILL_PERIOD       MS2ST(60)
+#endif
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void effectsStart(uint8_t stream);
+  systime_t effectsSparkleStep(void);
+  systime_t effectsRainStep(void);
+  systime_t effectsFillStep(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _EFFECTS_H_ */
@@ -0,0 +1,131 @@
+/**
+ *
+ * @file    font.c
+ *
+ * @brief   Led cube column bitmap font source file.
+ *
+ * @details Glyphs are three layers high and stored in flash already rotated
+ *          into columns, so that a column of a glyph can be copied as is
+ *          into a column of the frame buffer.
+ *          Each glyph is packed into a 16 bits word:
+ *          - bits 0..2: first column,
+ *          - bits 3..5: second column,
+ *          - bits 6..8: third column,
+ *          - bits 9..10: width of the glyph, zero if it is not defined.
+ *          .
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/pgmspace.h>
+
+/* Project local files. */
+#include "font.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+#define FONT_FIRST_CHAR           ' '
+#define FONT_LAST_CHAR            'Z'
+
+/**
+ * @brief   Glyphs from ' ' to 'Z'.
+ */
+static const uint16_t font_glyphs[] PROGMEM = {
+  0x0200, /* ' ' */
+  0x0000, /* '!' */
+  0x0000, /* '"' */
+  0x0000, /* '#' */
+  0x0000, /* '$' */
+  0x0000, /* '%' */
+  0x0000, /* '&' */
+  0x0000, /* ''' */
+  0x0000, /* '(' */
+  0x0000, /* ')' */
+  0x0000, /* '*' */
+  0x0000, /* '+' */
+  0x0000, /* ',' */
+  0x0412, /* '-' */
+  0x0201, /* '.' */
+  0x0000, /* '/' */
+  0x07EF, /* '0' */
+  0x043C, /* '1' */
+  0x067C, /* '2' */
+  0x07FD, /* '3' */
+  0x07D6, /* '4' */
+  0x0739, /* '5' */
+  0x06DF, /* '6' */
+  0x07E4, /* '7' */
+  0x07FF, /* '8' */
+  0x07F6, /* '9' */
+  0x0205, /* ':' */
+  0x0000, /* ';' */
+  0x0000, /* '<' */
+  0x0000, /* '=' */
+  0x0000, /* '>' */
+  0x0000, /* '?' */
+  0x0000, /* '@' */
+  0x06F3, /* 'A' */
+  0x06BF, /* 'B' */
+  0x076F, /* 'C' */
+  0x06AF, /* 'D' */
+  0x077F, /* 'E' */
+  0x0737, /* 'F' */
+  0x06EF, /* 'G' */
+  0x07D7, /* 'H' */
+  0x0207, /* 'I' */
+  0x078A, /* 'J' */
+  0x0757, /* 'K' */
+  0x064F, /* 'L' */
+  0x07F7, /* 'M' */
+  0x06E7, /* 'N' */
+  0x07EF, /* 'O' */
+  0x07B7, /* 'P' */
+  0x06EA, /* 'Q' */
+  0x06F7, /* 'R' */
+  0x0739, /* 'S' */
+  0x073C, /* 'T' */
+  0x07CF, /* 'U' */
+  0x078E, /* 'V' */
+  0x07DF, /* 'W' */
+  0x0755, /* 'X' */
+  0x071C, /* 'Y' */
+  0x067C  /* 'Z' */
+};
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Returns the packed glyph of a character.
+ * @note    Lower case letters use the upper case glyphs, characters without
+ *          a glyph are displayed as a space.
+ *
+ * @param[in] c     character to look up
+ * @return          the packed glyph.
+ */
+uint16_t fontGetGlyph(char c) {
+  uint16_t g;
+
+  if ((c >= 'a') && (c <= 'z'))
+    c -= 'a' - 'A';
+
+  if ((c < FONT_FIRST_CHAR) || (c > FONT_LAST_CHAR))
+    c = FONT_FIRST_CHAR;
+
+  g = pgm_read_word(&font_glyphs[c - FONT_FIRST_CHAR]);
+  if (g == 0)
+    g = pgm_read_word(&font_glyphs[0]);
+
+  return g;
+}
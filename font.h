@@ -0,0 +1,59 @@
+/**
+ *
+ * @file    font.h
+ *
+ * @brief   Led cube column bitmap font header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _FONT_H_
+#define _FONT_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdint.h>
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Widest glyph of the font, in columns.
+ */
+#define FONT_MAX_WIDTH            3
+
+/*==========================================================================*/
+/* Macros.                                                                  */
+/*==========================================================================*/
+
+/**
+ * @brief   Number of columns of a glyph.
+ */
+#define FONT_GLYPH_WIDTH(g)       ((uint8_t)((g) >> 9))
+
+/**
+ * @brief   Column @p c of a glyph, already in the frame buffer layout.
+ * @details Bit 0 is the bottom layer and bit 2 the top layer.
+ */
+#define FONT_GLYPH_COLUMN(g, c)   ((uint8_t)(((g) >> (3 * (c))) & 0x07))
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint16_t fontGetGlyph(char c);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FONT_H_ */
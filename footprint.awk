@@ -0,0 +1,293 @@
+##############################################################################
+#
+# @file   footprint.awk
+#
+# @brief  Flash, RAM and EEPROM usage of each module, read from the linker
+#         map file and checked against a budget file.
+#
+# @details Usage: awk -f footprint.awk -v kernel="..." -v hal="..."
+#                 -v ledcube="..." budget map
+#          The kernel, hal and ledcube variables list the object files of
+#          these groups, the other objects of the project are reported one
+#          by one, the toolchain libraries and start up files as "libc".
+#          The budget file has one line per module: name, flash, RAM and
+#          EEPROM budgets in bytes, "-" for no budget; "total" is the budget
+#          of the whole application. The exit status is 1 when a budget is
+#          exceeded or when the budgets of the modules add up to more than
+#          the total.
+#
+#          With -v generate=1 the budget file is printed back instead, the
+#          budgets of each module of the map set to its usage plus
+#          headroom percent, 25 by default, rounded up to 16 bytes. The
+#          headroom is lowered until the budgets fit in the total, the
+#          generation fails when the usage alone does not. Only the
+#          memories listed in -v memories, "flash ram eeprom" by default,
+#          are generated. The comments, the total and the other budgets
+#          are kept. The "# Generated from" and "# Toolchain:" lines name
+#          the map and -v toolchain.
+#
+# @author Theodore Ateba, tfateba@gmail.com
+#
+##############################################################################
+
+BEGIN {
+  n = split(kernel, list, " ")
+  for (i = 1; i <= n; i++)
+    group[list[i]] = "kernel"
+  n = split(hal, list, " ")
+  for (i = 1; i <= n; i++)
+    group[list[i]] = "hal"
+  n = split(ledcube, list, " ")
+  for (i = 1; i <= n; i++)
+    group[list[i]] = "ledcube"
+  if (min_buffer == "")
+    min_buffer = 16
+  if (headroom == "")
+    headroom = 25
+  if (memories == "")
+    memories = "flash ram eeprom"
+  n = split(memories, list, " ")
+  for (i = 1; i <= n; i++)
+    generated[list[i]] = 1
+  nmemories = split("flash ram eeprom", memory, " ")
+}
+
+# Value of a hexadecimal number.
+function hex(s,    i, v) {
+  v = 0
+  s = tolower(s)
+  sub(/^0x/, "", s)
+  for (i = 1; i <= length(s); i++)
+    v = (v * 16) + index("0123456789abcdef", substr(s, i, 1)) - 1
+  return v
+}
+
+# Module of an input file of the linker.
+function module(file,    name) {
+  if (file ~ /\.a\(/ || file !~ /obj\//)
+    return "libc"
+  name = file
+  sub(/.*\//, "", name)
+  if (name in group)
+    return group[name]
+  sub(/\.o$/, "", name)
+  return name
+}
+
+# Accounts an input section of the current output section.
+function account(section, size, file,    m, name) {
+  size = hex(size)
+  if (size == 0)
+    return
+  m = module(file)
+  modules[m] = 1
+  if (output == ".text" || output == ".data")
+    usage[m, "flash"] += size
+  if (output == ".data" || output == ".bss" || output == ".noinit") {
+    usage[m, "ram"] += size
+    if (size >= min_buffer) {
+      name = section
+      sub(/^\.(bss|data|noinit)\./, "", name)
+      buffers[m " " name] = size
+    }
+  }
+  if (output == ".eeprom")
+    usage[m, "eeprom"] += size
+}
+
+# Budget file.
+FNR == NR {
+  sub(/\r$/, "")
+  lines[++nlines] = $0
+  if ($0 !~ /^[ \t]*(#|$)/) {
+    budget[$1] = 1
+    limits[$1, "flash"] = $2
+    limits[$1, "ram"] = $3
+    limits[$1, "eeprom"] = $4
+  }
+  next
+}
+
+# Map file, only the memory map is read.
+/^Linker script and memory map/ {
+  mapped = 1
+  next
+}
+
+!mapped {
+  next
+}
+
+# Output section.
+/^\.[a-z]/ {
+  output = $1
+  pending = ""
+  next
+}
+
+# Input section, on one line or on two when its name is long.
+/^ [.A-Z]/ && NF == 4 && $2 ~ /^0x/ && $3 ~ /^0x/ {
+  account($1, $3, $4)
+  pending = ""
+  next
+}
+
+/^ [.A-Z]/ && NF == 1 {
+  pending = $1
+  next
+}
+
+pending != "" && NF == 3 && $1 ~ /^0x/ && $2 ~ /^0x/ {
+  account(pending, $2, $3)
+  pending = ""
+  next
+}
+
+{
+  pending = ""
+}
+
+# Checks one usage against its budget.
+function check(m, what, used, limit) {
+  if (limit == "-")
+    printf "warning: %s has no %s budget\n", m, what
+  else if ((limit != "") && (used > limit + 0)) {
+    printf "error: %s uses %d bytes of %s, its budget is %d\n",
+           m, used, what, limit
+    failed = 1
+  }
+}
+
+# Sum of the budgets of the modules for a memory, "-" counts for nothing.
+function budgets_sum(what,    m, sum) {
+  sum = 0
+  for (m in budget)
+    if ((m != "total") && (limits[m, what] != "-"))
+      sum += limits[m, what]
+  return sum
+}
+
+# Budget of a usage: the usage plus the headroom, rounded up to 16 bytes.
+function budget_of(used, headroom) {
+  used = int(((used * (100 + headroom)) + 99) / 100)
+  return int((used + 15) / 16) * 16
+}
+
+# Headroom of the generated budgets of a memory: the one asked, lowered
+# until the budgets fit in the total with the kept ones. -1 when the usage
+# alone does not fit.
+function fit(what,    kept, h, m, sum) {
+  kept = 0
+  for (m in budget)
+    if ((m != "total") && !(m in modules) && (limits[m, what] != "-"))
+      kept += limits[m, what]
+  for (h = headroom; h >= 0; h--) {
+    sum = kept
+    for (m in modules)
+      sum += budget_of(usage[m, what], h)
+    if ((limits["total", what] == "") || (sum <= limits["total", what] + 0))
+      return h
+  }
+  return -1
+}
+
+# Budget of a module for a memory, generated or kept.
+function budget_for(m, what) {
+  if (what in generated)
+    return budget_of(usage[m, what], fitted[what])
+  if ((m, what) in limits)
+    return limits[m, what]
+  return "-"
+}
+
+# Prints a budget line.
+function budget_line(m) {
+  printf "%-13s %-8s %-7s %s\n", m, budget_for(m, "flash"),
+         budget_for(m, "ram"), budget_for(m, "eeprom")
+}
+
+# Lines naming the map, the headroom of the generated budgets and the
+# toolchain.
+function generated_lines(    i, s) {
+  s = "# Generated from " FILENAME ":"
+  for (i = 1; i <= nmemories; i++)
+    if (memory[i] in generated)
+      s = s " " memory[i] " +" fitted[memory[i]] "%"
+  print s "."
+  if (toolchain != "")
+    print "# Toolchain: " toolchain "."
+}
+
+# Prints the budget file back with the budgets of the measured modules.
+function print_budgets(    i, f, m, stamped) {
+  for (i = 1; i <= nlines; i++) {
+    split(lines[i], f, " ")
+    m = f[1]
+    if (lines[i] ~ /^# (Generated from|Toolchain:) /)
+      continue
+    if ((lines[i] ~ /^# module/) && !stamped) {
+      generated_lines()
+      stamped = 1
+    }
+    if ((lines[i] ~ /^[ \t]*(#|$)/) || !(m in modules))
+      print lines[i]
+    else {
+      budget_line(m)
+      done[m] = 1
+    }
+  }
+  for (m in modules)
+    if (!(m in done))
+      budget_line(m)
+}
+
+END {
+  if (generate) {
+    for (w in generated) {
+      if ((fitted[w] = fit(w)) < 0) {
+        printf "error: the %s used does not fit in its total budget\n",
+               w > "/dev/stderr"
+        exit 1
+      }
+    }
+    print_budgets()
+    exit 0
+  }
+
+  printf "%-12s %8s %8s %8s\n", "module", "flash", "ram", "eeprom"
+  for (m in modules) {
+    printf "%-12s %8d %8d %8d\n", m, usage[m, "flash"], usage[m, "ram"],
+           usage[m, "eeprom"]
+    total_flash += usage[m, "flash"]
+    total_ram += usage[m, "ram"]
+    total_eeprom += usage[m, "eeprom"]
+    if (m in budget) {
+      check(m, "flash", usage[m, "flash"], limits[m, "flash"])
+      check(m, "ram", usage[m, "ram"], limits[m, "ram"])
+      check(m, "eeprom", usage[m, "eeprom"], limits[m, "eeprom"])
+    }
+    else {
+      printf "warning: %s has no budget\n", m
+    }
+  }
+  printf "%-12s %8d %8d %8d\n", "total", total_flash, total_ram, total_eeprom
+  check("total", "flash", total_flash, limits["total", "flash"])
+  check("total", "ram", total_ram, limits["total", "ram"])
+  check("total", "eeprom", total_eeprom, limits["total", "eeprom"])
+  for (i = 1; i <= nmemories; i++) {
+    w = memory[i]
+    if (budgets_sum(w) > limits["total", w] + 0) {
+      printf "error: the %s budgets of the modules add up to %d bytes, " \
+             "the total is %d\n", w, budgets_sum(w), limits["total", w]
+      failed = 1
+    }
+  }
+
+  printf "\nbuffers of %d bytes or more:\n", min_buffer
+  for (b in buffers) {
+    split(b, key, " ")
+    printf "%-12s %-24s %8d\n", key[1], key[2], buffers[b]
+  }
+
+  exit failed
+}
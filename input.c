@@ -0,0 +1,241 @@
+/**
+ *
+ * @file    input.c
+ *
+ * @brief   Led cube push button and rotary encoder source file.
+ *
+ * @details The inputs raise a pin change interrupt, nothing is polled.
+ *          A button press is taken on its first edge, the following edges
+ *          are ignored until the button stayed quiet for
+ *          @p INPUT_DEBOUNCE, a virtual timer ends the lockout. The encoder
+ *          is decoded on each edge, its bounces cancel out.
+ *          Each event wakes the animation thread, which handles it at once:
+ *          a detent changes the brightness without stepping, a press
+ *          selects the next animation and plays its first step.
+ *          The ChibiOS AVR port has no driver for the pin change
+ *          interrupts, the vector is served directly.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/pgmspace.h>
+
+/* Project local files. */
+#include "anim.h"
+#include "input.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Encoder direction, indexed by the previous and the new states.
+ */
+static const int8_t input_encoder_table[16] PROGMEM = {
+   0, -1,  1,  0,
+   1,  0,  0, -1,
+  -1,  0,  0,  1,
+   0,  1, -1,  0
+};
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Inputs state.
+ */
+static struct {
+  /* Button lockout timer.*/
+  virtual_timer_t vt;
+  /* Pins at the last edge.*/
+  uint8_t         pins;
+  /* Encoder transitions since the last detent.*/
+  int8_t          steps;
+  /* Events waiting for the animation thread.*/
+  uint8_t         presses;
+  int8_t          detents;
+  /* Time of the first waiting event.*/
+  systime_t       edge;
+  bool            pending;
+  /* Statistics.*/
+  input_stats_t   stats;
+} input;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Hands an event over to the animation thread.
+ */
+static void input_post_i(void) {
+
+  if (!input.pending) {
+    input.edge    = chVTGetSystemTimeX();
+    input.pending = true;
+  }
+  animWakeI();
+}
+
+/**
+ * @brief   Ends the button lockout.
+ *
+ * @param[in] arg   unused
+ */
+static void input_unlock_cb(void *arg) {
+
+  (void)arg;
+
+  chSysLockFromISR();
+  /* The button level settled, the next edge is a new press or release.*/
+  input.pins = (input.pins & ~INPUT_BUTTON) | (PINC & INPUT_BUTTON);
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Handles the edges of the inputs.
+ */
+static void input_edge_i(void) {
+  uint8_t pins = PINC & INPUT_MASK;
+  uint8_t changed = pins ^ input.pins;
+  uint8_t index;
+
+  if (changed & INPUT_BUTTON) {
+    if (chVTIsArmedI(&input.vt)) {
+      /* Bouncing, the lockout is extended.*/
+      chVTResetI(&input.vt);
+      pins = (pins & ~INPUT_BUTTON) | (input.pins & INPUT_BUTTON);
+    }
+    else if ((pins & INPUT_BUTTON) == 0) {
+      input.presses++;
+      input_post_i();
+    }
+    chVTSetI(&input.vt, INPUT_DEBOUNCE, input_unlock_cb, NULL);
+  }
+
+  if (changed & (INPUT_ENCODER_A | INPUT_ENCODER_B)) {
+    index = ((input.pins >> 2) & 0x0C) | ((pins >> 4) & 0x03);
+    input.steps += (int8_t)pgm_read_byte(&input_encoder_table[index]);
+    if (input.steps >= INPUT_ENCODER_STEPS) {
+      input.steps = 0;
+      input.detents++;
+      input_post_i();
+    }
+    else if (input.steps <= -INPUT_ENCODER_STEPS) {
+      input.steps = 0;
+      input.detents--;
+      input_post_i();
+    }
+  }
+
+  input.pins = pins;
+}
+
+/*==========================================================================*/
+/* Interrupt handlers.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Pin change interrupt of the port C.
+ */
+OSAL_IRQ_HANDLER(PCINT1_vect) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  osalSysLockFromISR();
+  input_edge_i();
+  osalSysUnlockFromISR();
+
+  OSAL_IRQ_EPILOGUE();
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Enables the inputs.
+ */
+void inputInit(void) {
+
+  chVTObjectInit(&input.vt);
+
+  /* The refresh is already running and writes PORTC from its interrupt,
+     the pins are changed with the interrupts disabled.*/
+  chSysLock();
+  DDRC  &= ~INPUT_MASK;
+  PORTC |= INPUT_MASK;
+  input.pins = PINC & INPUT_MASK;
+  PCMSK1 |= INPUT_MASK;
+  PCIFR   = (1 << PCIF1);
+  PCICR  |= (1 << PCIE1);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Handles the waiting events.
+ * @details The brightness is changed here, the animation to select is left
+ *          to the caller.
+ * @note    Called by the animation thread before each step and when an
+ *          event wakes it up.
+ *
+ * @return  the number of button presses.
+ */
+uint8_t inputProcess(void) {
+  uint8_t presses;
+  int8_t detents;
+  int16_t brightness;
+  systime_t latency;
+
+  chSysLock();
+  if (!input.pending) {
+    chSysUnlock();
+    return 0;
+  }
+  presses = input.presses;
+  detents = input.detents;
+  latency = chVTGetSystemTimeX() - input.edge;
+  input.presses = 0;
+  input.detents = 0;
+  input.pending = false;
+  chSysUnlock();
+
+  if (detents != 0) {
+    brightness = displayGetBrightness() + (detents * INPUT_BRIGHTNESS_STEP);
+    if (brightness < 0)
+      brightness = 0;
+    if (brightness > 255)
+      brightness = 255;
+    displaySetBrightness((uint8_t)brightness);
+  }
+
+  chSysLock();
+  input.stats.events++;
+  input.stats.latency = latency;
+  if (latency > input.stats.worst)
+    input.stats.worst = latency;
+  chSysUnlock();
+
+  return presses;
+}
+
+/**
+ * @brief   Returns the input statistics.
+ *
+ * @param[out] sp   statistics
+ */
+void inputGetStats(input_stats_t *sp) {
+
+  chSysLock();
+  *sp = input.stats;
+  chSysUnlock();
+}
@@ -0,0 +1,105 @@
+/**
+ *
+ * @file    input.h
+ *
+ * @brief   Led cube push button and rotary encoder header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _INPUT_H_
+#define _INPUT_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/* Project local files. */
+#include "display.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/*
+ * Inputs wiring on the Arduino Uno, all of them to the ground:
+ * - push button on A3 (PC3),
+ * - rotary encoder A and B on A4 and A5 (PC4 and PC5).
+ * The internal pull-ups are used.
+ */
+#define INPUT_BUTTON              (1U << 3)
+#define INPUT_ENCODER_A           (1U << 4)
+#define INPUT_ENCODER_B           (1U << 5)
+#define INPUT_MASK                (INPUT_BUTTON | INPUT_ENCODER_A |         \
+                                   INPUT_ENCODER_B)
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Time the button must be quiet before a new press is accepted.
+ */
+#if !defined(INPUT_DEBOUNCE)
+#define INPUT_DEBOUNCE            MS2ST(30)
+#endif
+
+/**
+ * @brief   Encoder transitions per detent.
+ */
+#if !defined(INPUT_ENCODER_STEPS)
+#define INPUT_ENCODER_STEPS       4
+#endif
+
+/**
+ * @brief   Brightness change per encoder detent.
+ */
+#if !defined(INPUT_BRIGHTNESS_STEP)
+#define INPUT_BRIGHTNESS_STEP     16
+#endif
+
+/*==========================================================================*/
+/* Derived constants and error checks.                                      */
+/*==========================================================================*/
+
+#if (DISPLAY_PINS_OR(C) & INPUT_MASK) != 0
+#error "DISPLAY_BOARD uses the pins of the inputs"
+#endif
+
+/*==========================================================================*/
+/* Data structures and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Input statistics.
+ */
+typedef struct {
+  /* Events handled.*/
+  uint16_t  events;
+  /* Time from the edge to the handling of the last and worst event.*/
+  systime_t latency;
+  systime_t worst;
+} input_stats_t;
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void inputInit(void);
+  uint8_t inputProcess(void);
+  void inputGetStats(input_stats_t *sp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INPUT_H_ */
@@ -20,15 +20,30 @@
 
 /* Project local files. */
 #include "ledcube.h"
+#include "display.h"
+#include "scroll.h"
+#include "anim.h"
+#include "store.h"
+#include "config.h"
+#include "boot.h"
+#include "rpc.h"
+#include "sio.h"
+#include "sync.h"
+#include "monitor.h"
+#include "telemetry.h"
+#include "input.h"
+#include "timecode.h"
 
-static THD_WORKING_AREA(waThread1, 64);
+/* Deepest path about 121 bytes, a stored frame read, plus the interrupts
+   above their reserve, see the telemetry stack bytes.*/
+static THD_WORKING_AREA(waThread1, 160);
 static THD_FUNCTION(Thread1, arg) {
   (void)arg;
 
   chRegSetThreadName("demo");
 
   while (true) {
-    ledCubeDemo();
+    animRun();
   }
 }
 
@@ -36,6 +51,14 @@ static THD_FUNCTION(Thread1, arg) {
  * Application entry point.
  */
 int main(void) {
+  char line[SCROLL_TEXT_SIZE];
+  size_t n = 0;
+  bool resync = false;
+
+  /*
+   * Boot time measurement, must come first.
+   */
+  bootStart();
 
   /*
    * System initializations.
@@ -45,12 +68,30 @@ int main(void) {
    *   RTOS is active.
    */
   halInit();
+  bootHalReady();
   chSysInit();
 
+  /*
+   * The boot frame is lit before anything else is initialized.
+   */
+  displayInit();
+  bootShowFirstFrame();
+
   /*
    * Initialization of the cube.
    */
   ledCubeInit();
+  sioInit();
+  scrollInit();
+  animInit();
+  inputInit();
+
+  /*
+   * Settings saved before the last reset.
+   */
+  storeInit();
+  configLoad();
+  configStart();
 
   /*
    * Activates the serial driver 1 using the driver default configuration.
@@ -58,11 +99,85 @@ int main(void) {
   sdStart(&SD1, NULL);
 
   /*
-   * Starts the LED blinker thread.
+   * The TX of a chained cube is the RX of the next one, which would take
+   * the report for a text line, so only binary records are sent there. The
+   * boot time is still read with RPC_STAT_BOOT_US.
+   */
+  if (syncGetRole() == SYNC_NONE)
+    bootReport((BaseSequentialStream *)&SD1);
+
+  /*
+   * Starts the animations thread, the boot frame stays until its first
+   * step.
    */
   chThdCreateStatic(waThread1, sizeof(waThread1), NORMALPRIO + 2, Thread1, NULL);
 
+  /*
+   * The watchdog resets the cube if the refresh or the animations stop
+   * keeping their deadlines.
+   */
+  monitorStart();
+
+  /*
+   * Serial commands are served above the animations, so they are answered
+   * within a frame whatever the animation does. The settings they change
+   * are stored by the settings thread, below the animations, the serial
+   * port is never left unread while the EEPROM is written.
+   */
+  chThdSetPriority(NORMALPRIO + 3);
+
+  /*
+   * Binary requests are served by the command interface, the ticks of a
+   * synchronization master and the timecode of a show controller are
+   * followed, the responses and the telemetry of the previous cube of a
+   * chain are dropped. Each line received on the serial port replaces the
+   * scrolled text, an empty line goes back to the demo and "@n" plays the
+   * animation n.
+   * A binary frame with a wrong length or CRC, or a byte which is not text,
+   * means bytes were lost: the binary frames are still followed but the
+   * text is dropped up to the next end of line, a lost frame header never
+   * makes its payload a text line.
+   */
   while(TRUE) {
-    chThdSleepMilliseconds(1000);
+    msg_t c = chnGetTimeout(&SD1, TIME_INFINITE);
+    bool ok = true;
+
+    if (c == RPC_SYNC) {
+      ok = rpcReceive((BaseChannel *)&SD1);
+    }
+    else if (c == RPC_REPLY) {
+      ok = rpcDrop((BaseChannel *)&SD1);
+    }
+    else if (c == SYNC_TICK) {
+      ok = syncReceive((BaseChannel *)&SD1);
+    }
+    else if (c == TIMECODE_FRAME) {
+      ok = timecodeReceive((BaseChannel *)&SD1);
+    }
+    else if (c == TELEMETRY_RECORD) {
+      ok = telemetryReceive((BaseChannel *)&SD1);
+    }
+    else if (c == '\n') {
+      if (resync) {
+        resync = false;
+      }
+      else if ((n == 2) && (line[0] == '@')) {
+        configSetAnim(line[1] - '0');
+      }
+      else {
+        configSetText(line, n);
+        configSetAnim((n > 0) ? ANIM_SCROLL : ANIM_DEMO);
+      }
+      n = 0;
+    }
+    else if ((c < ' ') || (c > '~')) {
+      ok = (c == '\r');
+    }
+    else if (n < sizeof(line)) {
+      line[n++] = (char)c;
+    }
+
+    if (!ok)
+      resync = true;
   }
 }
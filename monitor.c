@@ -0,0 +1,124 @@
+/**
+ *
+ * @file    monitor.c
+ *
+ * @brief   Led cube deadline monitor source file.
+ *
+ * @details A timer checks the deadline statistics of the refresh and of the
+ *          animations periodically and feeds the watchdog only while both
+ *          keep up: the cube resets instead of staying frozen or flickering.
+ *          The driver demo owns the cube pins without the refresh engine,
+ *          while it runs only its length is checked, against
+ *          @p MONITOR_DEMO_CHECKS.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/wdt.h>
+
+/* Project local files. */
+#include "display.h"
+#include "anim.h"
+#include "monitor.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Monitor state.
+ */
+static struct {
+  /* Check timer.*/
+  virtual_timer_t vt;
+  /* Statistics at the previous check.*/
+  uint16_t        scans;
+  uint16_t        missed;
+  uint16_t        steps;
+  /* Checks since the last animation step.*/
+  uint16_t        idle;
+} monitor;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Tells if the refresh and the animations kept their deadlines
+ *          since the previous check.
+ */
+static bool monitor_check_i(void) {
+  display_stats_t refresh;
+  anim_stats_t anim;
+  uint16_t checks = MONITOR_DEMO_CHECKS;
+  bool ok = true;
+
+  displayGetStatsI(&refresh);
+  animGetStatsI(&anim);
+
+  if (displayIsActive()) {
+    if ((refresh.scans == monitor.scans) ||
+        ((uint16_t)(refresh.missed - monitor.missed) > MONITOR_REFRESH_MISSES))
+      ok = false;
+    checks = MONITOR_ANIM_CHECKS;
+  }
+
+  /* The demo is one step, zero checks is no limit.*/
+  if (anim.steps != monitor.steps)
+    monitor.idle = 0;
+  else if (monitor.idle < checks)
+    monitor.idle++;
+  else if (checks > 0)
+    ok = false;
+
+  monitor.scans  = refresh.scans;
+  monitor.missed = refresh.missed;
+  monitor.steps  = anim.steps;
+
+  return ok;
+}
+
+/**
+ * @brief   Feeds the watchdog if the deadlines are kept and rearms the
+ *          check timer.
+ *
+ * @param[in] arg   unused
+ */
+static void monitor_cb(void *arg) {
+
+  (void)arg;
+
+  chSysLockFromISR();
+  if (monitor_check_i())
+    wdt_reset();
+  chVTSetI(&monitor.vt, MONITOR_PERIOD, monitor_cb, NULL);
+  chSysUnlockFromISR();
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Enables the watchdog and starts checking the deadlines.
+ * @note    The refresh engine and the animations must be running.
+ */
+void monitorStart(void) {
+
+  chVTObjectInit(&monitor.vt);
+  monitor.idle = 0;
+
+  chSysLock();
+  (void)monitor_check_i();
+  wdt_enable(MONITOR_WDT_TIMEOUT);
+  chVTSetI(&monitor.vt, MONITOR_PERIOD, monitor_cb, NULL);
+  chSysUnlock();
+}
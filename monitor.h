@@ -0,0 +1,85 @@
+/**
+ *
+ * @file    monitor.h
+ *
+ * @brief   Led cube deadline monitor header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _MONITOR_H_
+#define _MONITOR_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Time between two checks of the deadlines.
+ * @note    Must be well below the watchdog timeout.
+ */
+#if !defined(MONITOR_PERIOD)
+#define MONITOR_PERIOD            MS2ST(250)
+#endif
+
+/**
+ * @brief   Watchdog timeout, one of the @p WDTO_ constants.
+ */
+#if !defined(MONITOR_WDT_TIMEOUT)
+#define MONITOR_WDT_TIMEOUT       WDTO_1S
+#endif
+
+/**
+ * @brief   Late scans tolerated between two checks.
+ */
+#if !defined(MONITOR_REFRESH_MISSES)
+#define MONITOR_REFRESH_MISSES    4
+#endif
+
+/**
+ * @brief   Checks without any animation step before the watchdog is
+ *          starved.
+ * @note    Must cover the longest step, a stored animation frame lasts up
+ *          to 2 s and a follower waits half a step more.
+ */
+#if !defined(MONITOR_ANIM_CHECKS)
+#define MONITOR_ANIM_CHECKS       14
+#endif
+
+/**
+ * @brief   Checks the driver demo may last before the watchdog is starved,
+ *          zero for no limit.
+ * @note    The demo runs without the refresh engine and in one step, only
+ *          its length can be checked. Its length is the one of the ledcube
+ *          driver, not known here: by default the demo is not supervised
+ *          and a hung demo is not reset, set the length of the demo of the
+ *          driver used, plus some margin, to supervise it.
+ */
+#if !defined(MONITOR_DEMO_CHECKS)
+#define MONITOR_DEMO_CHECKS       0
+#endif
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void monitorStart(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MONITOR_H_ */
@@ -0,0 +1,128 @@
+/**
+ *
+ * @file    power.c
+ *
+ * @brief   Led cube idle sleep and idle time accounting source file.
+ *
+ * @details The idle thread puts the core in the idle sleep mode, the timers
+ *          and the UART keep running and any interrupt wakes it up. The
+ *          kernel is tickless, the core then only wakes for the scan timer,
+ *          the animation deadlines and the serial port.
+ *          The time spent in the idle thread is accounted from the context
+ *          switch hook, the interrupts served while sleeping are counted as
+ *          idle time. The hooks run on the idle thread stack or in an
+ *          interrupt epilogue, they only add ticks, the percentage is
+ *          computed when it is read.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/sleep.h>
+
+/* Project local files. */
+#include "power.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Idle time accounting state.
+ */
+static struct {
+  /* Start of the measurement window.*/
+  systime_t start;
+  /* Time the idle time was last accounted.*/
+  systime_t last;
+  /* Idle time in the current window.*/
+  systime_t idle;
+  /* The idle thread is running.*/
+  bool      idling;
+  /* Idle time and length of the last complete window.*/
+  systime_t last_idle;
+  systime_t last_window;
+} power;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Accounts the idle time up to now and closes the window when it
+ *          is complete.
+ */
+static void power_account_i(void) {
+  systime_t now = chVTGetSystemTimeX();
+  systime_t elapsed;
+
+  if (power.idling)
+    power.idle += now - power.last;
+  power.last = now;
+
+  elapsed = now - power.start;
+  if (elapsed >= POWER_WINDOW) {
+    power.last_idle   = power.idle;
+    power.last_window = elapsed;
+    power.idle  = 0;
+    power.start = now;
+  }
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Idle loop hook, sleeps until the next interrupt.
+ * @details An interrupt readying a thread switches to it before returning,
+ *          no wake up can be lost between the hook and the sleep.
+ */
+void powerIdleHook(void) {
+
+  chSysLock();
+  power_account_i();
+  chSysUnlock();
+
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_mode();
+}
+
+/**
+ * @brief   Context switch hook, accounts the time spent in the idle thread.
+ *
+ * @param[in] ntp   thread switched in
+ *
+ * @iclass
+ */
+void powerSwitchHookI(struct ch_thread *ntp) {
+
+  power_account_i();
+  power.idling = ntp->p_prio == IDLEPRIO;
+}
+
+/**
+ * @brief   Returns the fraction of time the core was idle.
+ *
+ * @return  the idle percentage over the last complete window.
+ */
+uint8_t powerGetIdlePercent(void) {
+  systime_t idle, window;
+
+  chSysLock();
+  idle   = power.last_idle;
+  window = power.last_window;
+  chSysUnlock();
+
+  if (window == 0)
+    return 0;
+
+  return (uint8_t)(((uint32_t)idle * 100U) / window);
+}
@@ -0,0 +1,47 @@
+/**
+ *
+ * @file    power.h
+ *
+ * @brief   Led cube idle sleep and idle time accounting header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _POWER_H_
+#define _POWER_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Time over which the idle fraction is measured.
+ * @note    Must stay below half the range of the system time.
+ */
+#if !defined(POWER_WINDOW)
+#define POWER_WINDOW              S2ST(1)
+#endif
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint8_t powerGetIdlePercent(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_H_ */
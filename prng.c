@@ -0,0 +1,104 @@
+/**
+ *
+ * @file    prng.c
+ *
+ * @brief   Led cube pseudo random numbers generator source file.
+ *
+ * @details 16 bits xorshift generator (7, 9, 8), its period is 65535 and a
+ *          draw is a handful of shifts and exclusive ors on the AVR.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Project local files. */
+#include "prng.h"
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Seeds a stream.
+ * @note    The generator is stuck on zero, a zero seed is replaced by
+ *          @p PRNG_SEED.
+ *
+ * @param[out] rp   pointer to the stream
+ * @param[in] seed  initial state
+ */
+void prngSeed(prng_t *rp, uint16_t seed) {
+
+  rp->state = (seed != 0) ? seed : PRNG_SEED;
+}
+
+/**
+ * @brief   Seeds a stream derived from @p PRNG_SEED.
+ * @details Each animation uses its own stream number, so it always draws the
+ *          same sequence whatever ran before it.
+ *
+ * @param[out] rp       pointer to the stream
+ * @param[in] stream    stream number
+ */
+void prngSeedStream(prng_t *rp, uint8_t stream) {
+  uint8_t i;
+
+  prngSeed(rp, PRNG_SEED ^ (uint16_t)(stream * 0x9E37U));
+
+  /* Close seeds give close first draws, mixes them a bit.*/
+  for (i = 0; i < 4; i++)
+    (void)prngNext(rp);
+}
+
+/**
+ * @brief   Draws the next number of a stream.
+ *
+ * @param[in,out] rp    pointer to the stream
+ * @return              a number in [1, 65535].
+ */
+uint16_t prngNext(prng_t *rp) {
+  uint16_t x = rp->state;
+
+  x ^= x << 7;
+  x ^= x >> 9;
+  x ^= x << 8;
+  rp->state = x;
+
+  return x;
+}
+
+/**
+ * @brief   Draws a number in [0, n).
+ * @note    Multiplies instead of dividing, there is no hardware divider.
+ *
+ * @param[in,out] rp    pointer to the stream
+ * @param[in] n         upper bound, excluded
+ * @return              the drawn number.
+ */
+uint8_t prngRange(prng_t *rp, uint8_t n) {
+
+  return (uint8_t)(((uint32_t)prngNext(rp) * n) >> 16);
+}
+
+/**
+ * @brief   Draws a random bit mask, typically a whole layer of the cube.
+ * @details Each bit is set with a probability of 1 / 2^sparsity, a zero
+ *          sparsity gives a full mask.
+ *
+ * @param[in,out] rp    pointer to the stream
+ * @param[in] sparsity  number of draws and-ed together
+ * @return              the drawn mask.
+ */
+uint16_t prngMask(prng_t *rp, uint8_t sparsity) {
+  uint16_t mask = 0xFFFF;
+
+  while (sparsity-- > 0)
+    mask &= prngNext(rp);
+
+  return mask;
+}
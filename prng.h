@@ -0,0 +1,62 @@
+/**
+ *
+ * @file    prng.h
+ *
+ * @brief   Led cube pseudo random numbers generator header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _PRNG_H_
+#define _PRNG_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdint.h>
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Seed all the streams are derived from.
+ * @note    Keep it fixed to get the same random animations after each reset.
+ */
+#if !defined(PRNG_SEED)
+#define PRNG_SEED                 0xACE1U
+#endif
+
+/*==========================================================================*/
+/* Data structures and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Random numbers stream.
+ */
+typedef struct {
+  uint16_t state;
+} prng_t;
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void prngSeed(prng_t *rp, uint16_t seed);
+  void prngSeedStream(prng_t *rp, uint8_t stream);
+  uint16_t prngNext(prng_t *rp);
+  uint8_t prngRange(prng_t *rp, uint8_t n);
+  uint16_t prngMask(prng_t *rp, uint8_t sparsity);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PRNG_H_ */
@@ -0,0 +1,398 @@
+/**
+ *
+ * @file    rpc.c
+ *
+ * @brief   Led cube binary command interface source file.
+ *
+ * @details The commands are dispatched through a table indexed by their
+ *          code, a request is decoded in constant time. Texts, playlists
+ *          and stored animations do not fit in one request, they are sent
+ *          in parts then committed.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/pgmspace.h>
+#include <util/crc16.h>
+
+/* Project local files. */
+#include "display.h"
+#include "scroll.h"
+#include "anim.h"
+#include "store.h"
+#include "config.h"
+#include "boot.h"
+#include "sio.h"
+#include "sync.h"
+#include "power.h"
+#include "telemetry.h"
+#include "input.h"
+#include "rpc.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Command handler.
+ *
+ * @param[in] req       request data
+ * @param[out] resp     response data, zeroed
+ * @return              the response status.
+ */
+typedef uint8_t (*rpc_handler_t)(const uint8_t *req, uint8_t *resp);
+
+/**
+ * @brief   Parts received before a commit.
+ */
+static struct {
+  char          text[SCROLL_TEXT_SIZE];
+  anim_entry_t  list[ANIM_PLAYLIST_SIZE];
+} rpc;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+static uint8_t rpc_crc(const uint8_t *p, uint8_t n) {
+  uint8_t crc = 0;
+
+  while (n-- > 0)
+    crc = _crc8_ccitt_update(crc, *p++);
+
+  return crc;
+}
+
+static uint8_t rpc_ping(const uint8_t *req, uint8_t *resp) {
+  uint8_t i;
+
+  for (i = 0; i < RPC_DATA_SIZE; i++)
+    resp[i] = req[i];
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_set_anim(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  if (req[0] >= ANIM_COUNT)
+    return RPC_ERR_ARG;
+
+  configSetAnim(req[0]);
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_get_anim(const uint8_t *req, uint8_t *resp) {
+
+  (void)req;
+  resp[0] = animGetSelected();
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_set_brightness(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  configSetBrightness(req[0]);
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_get_brightness(const uint8_t *req, uint8_t *resp) {
+
+  (void)req;
+  resp[0] = displayGetBrightness();
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_set_period(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  configSetLayerPeriod((systime_t)(req[0] | (req[1] << 8)));
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_get_period(const uint8_t *req, uint8_t *resp) {
+  systime_t period = displayGetLayerPeriod();
+
+  (void)req;
+  resp[0] = (uint8_t)period;
+  resp[1] = (uint8_t)(period >> 8);
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_text(const uint8_t *req, uint8_t *resp) {
+  uint8_t i;
+
+  (void)resp;
+  if (req[0] > (SCROLL_TEXT_SIZE - 3))
+    return RPC_ERR_ARG;
+
+  for (i = 0; i < 3; i++)
+    rpc.text[req[0] + i] = (char)req[1 + i];
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_text_commit(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  if (req[0] > SCROLL_TEXT_SIZE)
+    return RPC_ERR_ARG;
+
+  configSetText(rpc.text, req[0]);
+  configSetAnim((req[0] > 0) ? ANIM_SCROLL : ANIM_DEMO);
+
+  return RPC_OK;
+}
+
+/* The show parts are written to the EEPROM below the animations.*/
+static uint8_t rpc_show_begin(const uint8_t *req, uint8_t *resp) {
+  tprio_t prio;
+  bool ok;
+
+  (void)resp;
+
+  prio = chThdSetPriority(CONFIG_STORE_PRIO);
+  ok = storeWriteBegin(CONFIG_KEY_SHOW, req[0]);
+  chThdSetPriority(prio);
+
+  return ok ? RPC_OK : RPC_ERR_FAIL;
+}
+
+static uint8_t rpc_show_data(const uint8_t *req, uint8_t *resp) {
+  tprio_t prio;
+  bool ok;
+
+  (void)resp;
+  if (req[0] > 3)
+    return RPC_ERR_ARG;
+
+  prio = chThdSetPriority(CONFIG_STORE_PRIO);
+  ok = storeWriteData(&req[1], req[0]);
+  chThdSetPriority(prio);
+
+  return ok ? RPC_OK : RPC_ERR_FAIL;
+}
+
+static uint8_t rpc_show_end(const uint8_t *req, uint8_t *resp) {
+  tprio_t prio;
+  bool ok;
+
+  (void)req;
+  (void)resp;
+
+  prio = chThdSetPriority(CONFIG_STORE_PRIO);
+  ok = storeWriteEnd();
+  chThdSetPriority(prio);
+
+  return ok ? RPC_OK : RPC_ERR_FAIL;
+}
+
+static uint8_t rpc_playlist(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  if ((req[0] >= ANIM_PLAYLIST_SIZE) || (req[1] >= ANIM_COUNT))
+    return RPC_ERR_ARG;
+
+  rpc.list[req[0]].id      = req[1];
+  rpc.list[req[0]].seconds = req[2];
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_playlist_commit(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  if (req[0] > ANIM_PLAYLIST_SIZE)
+    return RPC_ERR_ARG;
+
+  configSetPlaylist(rpc.list, req[0]);
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_set_sync(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  if (req[0] > SYNC_FOLLOWER)
+    return RPC_ERR_ARG;
+
+  configSetSyncRole(req[0]);
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_telemetry(const uint8_t *req, uint8_t *resp) {
+
+  (void)resp;
+  telemetrySetPeriod(req[0]);
+
+  return RPC_OK;
+}
+
+static uint8_t rpc_get_stat(const uint8_t *req, uint8_t *resp) {
+  sync_stats_t sync;
+  anim_stats_t anim;
+  display_stats_t refresh;
+  input_stats_t input;
+  uint8_t duty[DISPLAY_LAYERS];
+  uint32_t value;
+
+  syncGetStats(&sync);
+  inputGetStats(&input);
+  chSysLock();
+  animGetStatsI(&anim);
+  displayGetStatsI(&refresh);
+  chSysUnlock();
+
+  switch (req[0]) {
+  case RPC_STAT_BOOT_US:
+    value = bootGetFirstFrameTime();
+    break;
+  case RPC_STAT_STORE_GEN:
+    value = storeGetGeneration();
+    break;
+  case RPC_STAT_SYNC_ERROR:
+    value = sync.max_error;
+    break;
+  case RPC_STAT_SYNC_LOST:
+    value = sync.lost;
+    break;
+  case RPC_STAT_ANIM_MISSED:
+    value = anim.missed;
+    break;
+  case RPC_STAT_ANIM_WORST:
+    value = anim.worst;
+    break;
+  case RPC_STAT_REFRESH_MISSED:
+    value = refresh.missed;
+    break;
+  case RPC_STAT_REFRESH_WORST:
+    value = refresh.worst;
+    break;
+  case RPC_STAT_RESET_CAUSE:
+    value = bootGetResetCause();
+    break;
+  case RPC_STAT_IDLE:
+    value = powerGetIdlePercent();
+    break;
+  case RPC_STAT_UNCHANGED:
+    value = refresh.unchanged;
+    break;
+  case RPC_STAT_DUTY:
+    displayGetDuty(duty);
+    value = duty[0] | ((uint16_t)duty[1] << 8) | ((uint32_t)duty[2] << 16);
+    break;
+  case RPC_STAT_INPUT_EVENTS:
+    value = input.events;
+    break;
+  case RPC_STAT_INPUT_LATENCY:
+    value = input.worst;
+    break;
+  default:
+    return RPC_ERR_ARG;
+  }
+
+  resp[0] = (uint8_t)value;
+  resp[1] = (uint8_t)(value >> 8);
+  resp[2] = (uint8_t)(value >> 16);
+  resp[3] = (uint8_t)(value >> 24);
+
+  return RPC_OK;
+}
+
+/**
+ * @brief   Handlers, indexed by the command codes.
+ */
+static const rpc_handler_t rpc_handlers[RPC_CMD_COUNT] PROGMEM = {
+  rpc_ping,
+  rpc_set_anim,
+  rpc_get_anim,
+  rpc_set_brightness,
+  rpc_get_brightness,
+  rpc_set_period,
+  rpc_get_period,
+  rpc_text,
+  rpc_text_commit,
+  rpc_show_begin,
+  rpc_show_data,
+  rpc_show_end,
+  rpc_playlist,
+  rpc_playlist_commit,
+  rpc_get_stat,
+  rpc_set_sync,
+  rpc_telemetry
+};
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Receives a request, executes it and sends the response.
+ * @note    Called once the @p RPC_SYNC byte has been read, an incomplete
+ *          request is dropped silently.
+ *
+ * @param[in] chp   channel the request comes from
+ * @return          false if the request was incomplete or its CRC wrong.
+ * @note    The response is sent on SD1.
+ */
+bool rpcReceive(BaseChannel *chp) {
+  rpc_request_t req;
+  rpc_response_t resp = {0};
+  rpc_handler_t handler;
+
+  req.sync = RPC_SYNC;
+  if (chnReadTimeout(chp, &req.cmd, sizeof(req) - 1, RPC_TIMEOUT) !=
+      (sizeof(req) - 1))
+    return false;
+
+  resp.sync = RPC_REPLY;
+  resp.cmd  = req.cmd;
+  resp.seq  = req.seq;
+
+  if (rpc_crc((const uint8_t *)&req, sizeof(req) - 1) != req.crc) {
+    resp.status = RPC_ERR_CRC;
+  }
+  else if (req.cmd >= RPC_CMD_COUNT) {
+    resp.status = RPC_ERR_CMD;
+  }
+  else {
+    handler = (rpc_handler_t)pgm_read_ptr(&rpc_handlers[req.cmd]);
+    resp.status = handler(req.data, resp.data);
+  }
+
+  resp.crc = rpc_crc((const uint8_t *)&resp, sizeof(resp) - 1);
+  (void)sioWrite((const uint8_t *)&resp, sizeof(resp), TIME_INFINITE);
+
+  return resp.status != RPC_ERR_CRC;
+}
+
+/**
+ * @brief   Drops a response sent by the previous cube of a chain.
+ * @note    Called once the @p RPC_REPLY byte has been read.
+ *
+ * @param[in] chp   channel the response comes from
+ * @return          false if the response was incomplete or its CRC wrong.
+ */
+bool rpcDrop(BaseChannel *chp) {
+  uint8_t resp[sizeof(rpc_response_t)];
+
+  resp[0] = RPC_REPLY;
+  return (chnReadTimeout(chp, &resp[1], sizeof(resp) - 1, RPC_TIMEOUT) ==
+          (sizeof(resp) - 1)) &&
+         (rpc_crc(resp, sizeof(resp) - 1) == resp[sizeof(resp) - 1]);
+}
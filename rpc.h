@@ -0,0 +1,153 @@
+/**
+ *
+ * @file    rpc.h
+ *
+ * @brief   Led cube binary command interface header file.
+ *
+ * @details Requests and responses have a fixed size. Requests start with
+ *          @p RPC_SYNC and responses with @p RPC_REPLY, bytes never found
+ *          in the text lines also accepted on the serial port. The last
+ *          byte is the CRC8 (polynomial 0x07, as _crc8_ccitt_update()) of
+ *          all the previous ones. Multi bytes values are little endian.
+ *          Each request gets one response which echoes its command and
+ *          sequence number. The responses of a cube also reach the next
+ *          cube of a chain, which drops them.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _RPC_H_
+#define _RPC_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   First byte of requests.
+ */
+#define RPC_SYNC                  0xA5
+
+/**
+ * @brief   First byte of responses.
+ */
+#define RPC_REPLY                 0xA4
+
+/**
+ * @brief   Size of the data field of requests and responses.
+ */
+#define RPC_DATA_SIZE             4
+
+/**
+ * @brief   Time allowed to receive the rest of a request.
+ */
+#define RPC_TIMEOUT               MS2ST(20)
+
+/**
+ * @name    Commands
+ * @{
+ */
+#define RPC_CMD_PING              0x00  /* data echoed.                    */
+#define RPC_CMD_SET_ANIM          0x01  /* [0] animation.                  */
+#define RPC_CMD_GET_ANIM          0x02  /* -> [0] animation.               */
+#define RPC_CMD_SET_BRIGHTNESS    0x03  /* [0] brightness.                 */
+#define RPC_CMD_GET_BRIGHTNESS    0x04  /* -> [0] brightness.              */
+#define RPC_CMD_SET_PERIOD        0x05  /* [0..1] layer period in ticks.   */
+#define RPC_CMD_GET_PERIOD        0x06  /* -> [0..1] layer period.         */
+#define RPC_CMD_TEXT              0x07  /* [0] offset, [1..3] characters.  */
+#define RPC_CMD_TEXT_COMMIT       0x08  /* [0] length, scrolls the text.   */
+#define RPC_CMD_SHOW_BEGIN        0x09  /* [0] stored animation length.    */
+#define RPC_CMD_SHOW_DATA         0x0A  /* [0] count, [1..3] bytes.        */
+#define RPC_CMD_SHOW_END          0x0B  /* stores the animation.           */
+#define RPC_CMD_PLAYLIST          0x0C  /* [0] entry, [1] anim, [2] secs.  */
+#define RPC_CMD_PLAYLIST_COMMIT   0x0D  /* [0] entries, starts playing.    */
+#define RPC_CMD_GET_STAT          0x0E  /* [0] statistic -> [0..3] value.  */
+#define RPC_CMD_SET_SYNC          0x0F  /* [0] synchronization role.       */
+#define RPC_CMD_TELEMETRY         0x10  /* [0] frames per record, 0 off.   */
+#define RPC_CMD_COUNT             0x11
+/** @} */
+
+/**
+ * @name    Response status
+ * @{
+ */
+#define RPC_OK                    0x00
+#define RPC_ERR_CMD               0x01
+#define RPC_ERR_ARG               0x02
+#define RPC_ERR_FAIL              0x03
+#define RPC_ERR_CRC               0x04
+/** @} */
+
+/**
+ * @name    Statistics
+ * @{
+ */
+#define RPC_STAT_BOOT_US          0x00  /* first frame, in us, see boot.h. */
+#define RPC_STAT_STORE_GEN        0x01  /* EEPROM bank generation.         */
+#define RPC_STAT_SYNC_ERROR       0x02  /* worst tick error, in ticks.     */
+#define RPC_STAT_SYNC_LOST        0x03  /* ticks missed by the follower.   */
+#define RPC_STAT_ANIM_MISSED      0x04  /* animation steps played late.    */
+#define RPC_STAT_ANIM_WORST       0x05  /* worst step overrun, in ticks.   */
+#define RPC_STAT_REFRESH_MISSED   0x06  /* late layer scan timer events.   */
+#define RPC_STAT_REFRESH_WORST    0x07  /* worst scan lateness, in ticks.  */
+#define RPC_STAT_RESET_CAUSE      0x08  /* MCUSR flags of the last reset.  */
+#define RPC_STAT_IDLE             0x09  /* idle time, in percent.          */
+#define RPC_STAT_UNCHANGED        0x0A  /* frames identical to the last.   */
+#define RPC_STAT_DUTY             0x0B  /* [0..2] layers duty, in percent. */
+#define RPC_STAT_INPUT_EVENTS     0x0C  /* button and encoder events.      */
+#define RPC_STAT_INPUT_LATENCY    0x0D  /* worst edge to handling, ticks.  */
+#define RPC_STAT_COUNT            0x0E
+/** @} */
+
+/*==========================================================================*/
+/* Data structures and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Request.
+ */
+typedef struct {
+  uint8_t   sync;
+  uint8_t   cmd;
+  uint8_t   seq;
+  uint8_t   data[RPC_DATA_SIZE];
+  uint8_t   crc;
+} rpc_request_t;
+
+/**
+ * @brief   Response.
+ */
+typedef struct {
+  uint8_t   sync;
+  uint8_t   cmd;
+  uint8_t   seq;
+  uint8_t   status;
+  uint8_t   data[RPC_DATA_SIZE];
+  uint8_t   crc;
+} rpc_response_t;
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  bool rpcReceive(BaseChannel *chp);
+  bool rpcDrop(BaseChannel *chp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RPC_H_ */
@@ -0,0 +1,173 @@
+/**
+ *
+ * @file    scroll.c
+ *
+ * @brief   Led cube scrolling text source file.
+ *
+ * @details The text runs around the four side faces of the cube. The eight
+ *          columns of the perimeter are kept in a ring, so a scroll step
+ *          only moves the head of the ring and inserts the next column of
+ *          the current glyph.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <string.h>
+
+/* AVR files. */
+#include <avr/pgmspace.h>
+
+/* Project local files. */
+#include "display.h"
+#include "font.h"
+#include "scroll.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Number of columns on the perimeter of the cube.
+ */
+#define SCROLL_RING_SIZE          8
+
+/**
+ * @brief   Frame buffer columns of the perimeter, in scrolling order.
+ */
+static const uint8_t scroll_ring_map[SCROLL_RING_SIZE] PROGMEM = {
+  DISPLAY_COLUMN(0, 0), DISPLAY_COLUMN(1, 0), DISPLAY_COLUMN(2, 0),
+  DISPLAY_COLUMN(2, 1), DISPLAY_COLUMN(2, 2), DISPLAY_COLUMN(1, 2),
+  DISPLAY_COLUMN(0, 2), DISPLAY_COLUMN(0, 1)
+};
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Scroller state.
+ */
+static struct {
+  /* Text being scrolled.*/
+  char              text[SCROLL_TEXT_SIZE];
+  /* Length of the text, zero disables the scroller.*/
+  uint8_t           len;
+  /* Character being inserted.*/
+  uint8_t           pos;
+  /* Column of the character being inserted.*/
+  uint8_t           col;
+  /* Perimeter columns, oldest first from the head.*/
+  uint8_t           ring[SCROLL_RING_SIZE];
+  uint8_t           head;
+  /* Frame drawn by the scroller.*/
+  display_frame_t   frame;
+} scroll;
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Initializes the scroller, without any text.
+ */
+void scrollInit(void) {
+
+  memset(&scroll, 0, sizeof(scroll));
+}
+
+/**
+ * @brief   Replaces the scrolled text.
+ * @note    The text is truncated to @p SCROLL_TEXT_SIZE characters, an
+ *          empty text disables the scroller.
+ *
+ * @param[in] text  characters to scroll, not necessarily terminated
+ * @param[in] n     number of characters
+ */
+void scrollSetText(const char *text, size_t n) {
+
+  if (n > SCROLL_TEXT_SIZE)
+    n = SCROLL_TEXT_SIZE;
+
+  chSysLock();
+  memcpy(scroll.text, text, n);
+  scroll.len = (uint8_t)n;
+  scroll.pos = 0;
+  scroll.col = 0;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the scrolled text.
+ *
+ * @param[out] text     characters scrolled, @p SCROLL_TEXT_SIZE at most, not
+ *                      terminated
+ * @return              the number of characters.
+ */
+uint8_t scrollGetText(char *text) {
+  uint8_t n;
+
+  chSysLock();
+  n = scroll.len;
+  memcpy(text, scroll.text, n);
+  chSysUnlock();
+
+  return n;
+}
+
+/**
+ * @brief   Tells if there is a text to scroll.
+ *
+ * @return  true when a text is set.
+ */
+bool scrollIsEnabled(void) {
+
+  return scroll.len > 0;
+}
+
+/**
+ * @brief   Scrolls the text by one column and commits the new frame.
+ */
+void scrollStep(void) {
+  uint8_t column = 0;
+  uint8_t i;
+
+  chSysLock();
+  if (scroll.pos < scroll.len) {
+    uint16_t g = fontGetGlyph(scroll.text[scroll.pos]);
+
+    if (scroll.col < FONT_GLYPH_WIDTH(g))
+      column = FONT_GLYPH_COLUMN(g, scroll.col);
+
+    /* One blank column after each glyph.*/
+    if (++scroll.col > FONT_GLYPH_WIDTH(g)) {
+      scroll.col = 0;
+      scroll.pos++;
+    }
+  }
+  else {
+    /* Blank tail, the text leaves the ring before it comes back.*/
+    if (++scroll.col >= SCROLL_RING_SIZE) {
+      scroll.col = 0;
+      scroll.pos = 0;
+    }
+  }
+  chSysUnlock();
+
+  scroll.ring[scroll.head] = column;
+  scroll.head = (scroll.head + 1) & (SCROLL_RING_SIZE - 1);
+
+  for (i = 0; i < SCROLL_RING_SIZE; i++) {
+    scroll.frame.col[pgm_read_byte(&scroll_ring_map[i])] =
+      scroll.ring[(scroll.head + i) & (SCROLL_RING_SIZE - 1)];
+  }
+
+  displayCommit(&scroll.frame);
+}
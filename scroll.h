@@ -0,0 +1,57 @@
+/**
+ *
+ * @file    scroll.h
+ *
+ * @brief   Led cube scrolling text header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _SCROLL_H_
+#define _SCROLL_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Maximum length of the scrolled text.
+ */
+#if !defined(SCROLL_TEXT_SIZE)
+#define SCROLL_TEXT_SIZE          32
+#endif
+
+/**
+ * @brief   Time between two scroll steps, in system ticks.
+ */
+#if !defined(SCROLL_STEP_PERIOD)
+#define SCROLL_STEP_PERIOD        MS2ST(150)
+#endif
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void scrollInit(void);
+  void scrollSetText(const char *text, size_t n);
+  uint8_t scrollGetText(char *text);
+  bool scrollIsEnabled(void);
+  void scrollStep(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SCROLL_H_ */
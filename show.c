@@ -0,0 +1,228 @@
+/**
+ *
+ * @file    show.c
+ *
+ * @brief   Led cube stored animation player source file.
+ *
+ * @details The animation is read from the persistent store, frame by frame,
+ *          it is never copied in RAM. Its format is:
+ *          - frame period in units of 10 ms (1 byte, 2 s at most),
+ *          - frames, each one being:
+ *            - mask of the columns which changed since the previous frame
+ *              (2 bytes, little endian, bit c is column c),
+ *            - new value of each changed column (1 byte each).
+ *            .
+ *          .
+ *          The first frame is a change from a blank cube, the animation is
+ *          played in loop.
+ *          The animation is indexed each time it starts: the whole cube
+ *          and the offset of every @p SHOW_INDEX_INTERVAL frames are kept,
+ *          a seek starts from the closest of them.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Project local files. */
+#include "display.h"
+#include "store.h"
+#include "config.h"
+#include "show.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Most frames of an animation, two bytes each at least.
+ */
+#define SHOW_MAX_FRAMES           ((STORE_MAX_PAYLOAD - 1) / 2)
+
+/**
+ * @brief   Entries of the keyframe index.
+ */
+#define SHOW_INDEX_SIZE                                                     \
+  ((SHOW_MAX_FRAMES + SHOW_INDEX_INTERVAL - 1) / SHOW_INDEX_INTERVAL)
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Entry of the keyframe index.
+ */
+typedef struct {
+  /* Cube before the indexed frame.*/
+  display_frame_t   frame;
+  /* Offset of the indexed frame in the record.*/
+  uint8_t           offset;
+} show_key_t;
+
+/**
+ * @brief   Player state.
+ */
+static struct {
+  /* Frame being played.*/
+  display_frame_t   frame;
+  /* Offset of the next frame in the record.*/
+  uint8_t           offset;
+  /* Number of the next frame and number of frames.*/
+  uint8_t           next;
+  uint8_t           frames;
+  /* Frame period.*/
+  systime_t         period;
+  /* Keyframe index.*/
+  show_key_t        index[SHOW_INDEX_SIZE];
+} show;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Reads the next frame of the stored animation.
+ *
+ * @return  false at the end of the animation.
+ */
+static bool show_read_frame(void) {
+  uint8_t data[DISPLAY_COLUMNS];
+  uint8_t mask[2];
+  uint16_t changed;
+  uint8_t c, n = 0;
+
+  if ((show.offset > (STORE_MAX_PAYLOAD - 2)) ||
+      (storeRead(CONFIG_KEY_SHOW, show.offset, mask, 2) != 2))
+    return false;
+
+  changed = mask[0] | (mask[1] << 8);
+  for (c = 0; c < DISPLAY_COLUMNS; c++) {
+    if (changed & (1U << c))
+      n++;
+  }
+  if ((n > 0) && (storeRead(CONFIG_KEY_SHOW, show.offset + 2, data, n) != n))
+    return false;
+  show.offset += 2 + n;
+
+  n = 0;
+  for (c = 0; c < DISPLAY_COLUMNS; c++) {
+    if (changed & (1U << c))
+      show.frame.col[c] = data[n++];
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Makes a frame the next one played.
+ * @details The frames are replayed from the closest keyframe before it.
+ *
+ * @param[in] frame     frame number, less than the number of frames
+ */
+static void show_goto(uint8_t frame) {
+  const show_key_t *kp = &show.index[frame / SHOW_INDEX_INTERVAL];
+
+  show.frame  = kp->frame;
+  show.offset = kp->offset;
+  show.next   = frame;
+
+  for (frame %= SHOW_INDEX_INTERVAL; frame > 0; frame--)
+    (void)show_read_frame();
+}
+
+/**
+ * @brief   Reads the frame period and indexes the stored animation, then
+ *          rewinds it.
+ * @note    Done again at each loop, the animation may have been replaced.
+ */
+static void show_load(void) {
+  show_key_t *kp;
+  uint8_t period = 0;
+
+  (void)storeRead(CONFIG_KEY_SHOW, 0, &period, 1);
+  if (period > 200)
+    period = 200;
+  if (period == 0)
+    period = 10;
+  show.period = MS2ST(10 * period);
+
+  displayClear(&show.frame);
+  show.offset = 1;
+  show.frames = 0;
+  while (show.frames < SHOW_MAX_FRAMES) {
+    if ((show.frames % SHOW_INDEX_INTERVAL) == 0) {
+      kp = &show.index[show.frames / SHOW_INDEX_INTERVAL];
+      kp->frame  = show.frame;
+      kp->offset = show.offset;
+    }
+    if (!show_read_frame())
+      break;
+    show.frames++;
+  }
+
+  show_goto(0);
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Rewinds the stored animation.
+ */
+void showStart(void) {
+
+  show_load();
+}
+
+/**
+ * @brief   Plays the next frame of the stored animation.
+ *
+ * @return  time until the next frame.
+ */
+systime_t showStep(void) {
+
+  /* Loops, an empty or missing animation gives a blank cube.*/
+  if (show.next >= show.frames)
+    show_load();
+
+  if (show.frames > 0) {
+    (void)show_read_frame();
+    show.next++;
+  }
+
+  displayCommit(&show.frame);
+
+  return show.period;
+}
+
+/**
+ * @brief   Moves the next frame to the one shown at a time.
+ * @details Nothing is done when the animation is less than one frame away
+ *          from the time, else at most @p SHOW_INDEX_INTERVAL - 1 frames
+ *          are replayed whatever the time.
+ *
+ * @param[in] ticks time since the start of the animation
+ * @return          false if nothing was done.
+ */
+bool showSeek(uint32_t ticks) {
+  uint8_t frame, next, shown;
+
+  if (show.frames == 0)
+    return false;
+
+  frame = (ticks / show.period) % show.frames;
+  next  = (show.next < show.frames) ? show.next : 0;
+  shown = (next > 0) ? next - 1 : show.frames - 1;
+  if ((frame == next) || (frame == shown))
+    return false;
+
+  show_goto(frame);
+
+  return true;
+}
@@ -0,0 +1,50 @@
+/**
+ *
+ * @file    show.h
+ *
+ * @brief   Led cube stored animation player header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _SHOW_H_
+#define _SHOW_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Frames between two entries of the keyframe index.
+ * @details A seek replays at most this number of frames minus one, a
+ *          smaller interval takes more RAM.
+ */
+#if !defined(SHOW_INDEX_INTERVAL)
+#define SHOW_INDEX_INTERVAL       16
+#endif
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void showStart(void);
+  systime_t showStep(void);
+  bool showSeek(uint32_t ticks);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SHOW_H_ */
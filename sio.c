@@ -0,0 +1,69 @@
+/**
+ *
+ * @file    sio.c
+ *
+ * @brief   Led cube shared serial output source file.
+ *
+ * @details Several threads send binary records on SD1, a record is always
+ *          written as a whole so records of different threads never mix.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Project local files. */
+#include "sio.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Serializes the writers of SD1.
+ */
+static mutex_t sio_mtx;
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Initializes the shared serial output.
+ */
+void sioInit(void) {
+
+  chMtxObjectInit(&sio_mtx);
+}
+
+/**
+ * @brief   Writes a record on SD1.
+ * @note    With @p TIME_IMMEDIATE the record is only written if the output
+ *          queue has room for all of it, the caller never waits.
+ *
+ * @param[in] bp        record
+ * @param[in] n         record size
+ * @param[in] timeout   time allowed to queue the record
+ * @return              false if the record was not written completely.
+ */
+bool sioWrite(const uint8_t *bp, uint8_t n, systime_t timeout) {
+  bool fits = true;
+  size_t written = 0;
+
+  chMtxLock(&sio_mtx);
+  if (timeout == TIME_IMMEDIATE) {
+    chSysLock();
+    fits = oqGetEmptyI(&SD1.oqueue) >= n;
+    chSysUnlock();
+  }
+  if (fits)
+    written = chnWriteTimeout(&SD1, bp, n, timeout);
+  chMtxUnlock(&sio_mtx);
+
+  return written == n;
+}
@@ -0,0 +1,37 @@
+/**
+ *
+ * @file    sio.h
+ *
+ * @brief   Led cube shared serial output header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _SIO_H_
+#define _SIO_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void sioInit(void);
+  bool sioWrite(const uint8_t *bp, uint8_t n, systime_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIO_H_ */
@@ -0,0 +1,515 @@
+/**
+ *
+ * @file    store.c
+ *
+ * @brief   Led cube persistent store source file.
+ *
+ * @details The EEPROM is split in two banks, one of them is active and holds
+ *          an append only log of records:
+ *          - key (1 byte), 0xFF marks the end of the log,
+ *          - payload length (1 byte),
+ *          - payload,
+ *          - CRC8 of the key, the length and the payload (1 byte).
+ *          .
+ *          Writing a key appends a new record, the last record of a key
+ *          wins. When the active bank is full the live records are copied
+ *          to the other bank which becomes the active one, so each cell is
+ *          only written once per bank fill.
+ *          A bank starts with its generation number and a magic byte, the
+ *          valid bank with the newest generation is the active one.
+ *          The key byte of a record is written last, a record torn by a
+ *          power loss is never seen.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
+/* Project local files. */
+#include "store.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+#define STORE_BANK_SIZE           (STORE_SIZE / 2)
+#define STORE_HEADER_SIZE         2
+#define STORE_MAGIC               0xC5
+#define STORE_FREE                0xFF
+
+/* Offsets in a bank header.*/
+#define STORE_GEN                 0
+#define STORE_MAGIC_OFFSET        1
+
+/* Record size around the payload.*/
+#define STORE_OVERHEAD            3
+
+/* Time after which a record written by parts is taken as abandoned by its
+   client, below the 4 s wrap of the system time.*/
+#define STORE_PART_TIMEOUT        MS2ST(2000)
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Store state.
+ */
+static struct {
+  /* Serializes the accesses to the EEPROM.*/
+  mutex_t   mtx;
+  /* Address of the active bank.*/
+  uint16_t  base;
+  /* Address of the end of the log.*/
+  uint16_t  end;
+  /* Generation of the active bank.*/
+  uint8_t   gen;
+  /* Address of the last record of each key, zero when there is none.*/
+  uint16_t  index[STORE_KEYS];
+  /* Record being written by parts, zero when there is none.*/
+  uint8_t   key;
+  uint8_t   len;
+  uint8_t   pos;
+  uint8_t   crc;
+  /* Time its last part was written.*/
+  systime_t stamp;
+} store;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+static inline uint8_t store_read_byte(uint16_t addr) {
+
+  return eeprom_read_byte((const uint8_t *)addr);
+}
+
+static inline void store_write_byte(uint16_t addr, uint8_t value) {
+
+  /* Only the bytes which change are written, saves the cells.*/
+  eeprom_update_byte((uint8_t *)addr, value);
+}
+
+/**
+ * @brief   Tells if a bank is valid.
+ *
+ * @param[in] base  address of the bank
+ * @return          true when the bank header is valid.
+ */
+static bool store_bank_is_valid(uint16_t base) {
+
+  return store_read_byte(base + STORE_MAGIC_OFFSET) == STORE_MAGIC;
+}
+
+/**
+ * @brief   Computes the CRC of a record.
+ *
+ * @param[in] addr  address of the record
+ * @param[in] key   record key
+ * @param[in] len   payload length
+ * @return          the CRC.
+ */
+static uint8_t store_crc(uint16_t addr, uint8_t key, uint8_t len) {
+  uint8_t crc = 0;
+
+  crc = _crc8_ccitt_update(crc, key);
+  crc = _crc8_ccitt_update(crc, len);
+  addr += 2;
+  while (len-- > 0)
+    crc = _crc8_ccitt_update(crc, store_read_byte(addr++));
+
+  return crc;
+}
+
+/**
+ * @brief   Scans the log of the active bank and rebuilds the index.
+ */
+static void store_scan(void) {
+  uint16_t addr = store.base + STORE_HEADER_SIZE;
+  uint16_t limit = store.base + STORE_BANK_SIZE;
+  uint8_t key, len;
+
+  for (key = 0; key < STORE_KEYS; key++)
+    store.index[key] = 0;
+
+  while ((addr + STORE_OVERHEAD) <= limit) {
+    key = store_read_byte(addr);
+    if (key == STORE_FREE)
+      break;
+
+    len = store_read_byte(addr + 1);
+    if ((addr + STORE_OVERHEAD + len) > limit)
+      break;
+
+    /* Bad records are skipped, the previous one of the key stays.*/
+    if ((key < STORE_KEYS) &&
+        (store_crc(addr, key, len) == store_read_byte(addr + 2 + len)))
+      store.index[key] = addr;
+
+    addr += STORE_OVERHEAD + len;
+  }
+
+  store.end = addr;
+}
+
+/**
+ * @brief   Writes a record at the end of the log.
+ * @note    The caller checked that the record fits in the bank.
+ *
+ * @param[in] key   record key
+ * @param[in] buf   payload, NULL to copy it from the EEPROM
+ * @param[in] src   address of the payload when @p buf is NULL
+ * @param[in] n     payload length
+ */
+static void store_append(uint8_t key, const uint8_t *buf, uint16_t src,
+                         uint8_t n) {
+  uint16_t addr = store.end;
+  uint16_t next = addr + STORE_OVERHEAD + n;
+  uint8_t crc = 0;
+  uint8_t i, b;
+
+  crc = _crc8_ccitt_update(crc, key);
+  crc = _crc8_ccitt_update(crc, n);
+
+  store_write_byte(addr + 1, n);
+  for (i = 0; i < n; i++) {
+    b = (buf != NULL) ? buf[i] : store_read_byte(src + i);
+    crc = _crc8_ccitt_update(crc, b);
+    store_write_byte(addr + 2 + i, b);
+  }
+  store_write_byte(addr + 2 + n, crc);
+
+  /* Old data of a previous bank fill may follow, ends the log first.*/
+  if (next < (store.base + STORE_BANK_SIZE))
+    store_write_byte(next, STORE_FREE);
+
+  store_write_byte(addr, key);
+
+  store.index[key] = addr;
+  store.end = next;
+}
+
+/**
+ * @brief   Copies the live records into the other bank and activates it.
+ */
+static void store_compact(void) {
+  uint16_t from = store.base;
+  uint16_t to = (store.base == 0) ? STORE_BANK_SIZE : 0;
+  uint16_t index[STORE_KEYS];
+  uint8_t key;
+
+  for (key = 0; key < STORE_KEYS; key++)
+    index[key] = store.index[key];
+
+  /* The target bank stays invalid until the copy is complete.*/
+  store_write_byte(to + STORE_MAGIC_OFFSET, 0);
+  store.base = to;
+  store.end  = to + STORE_HEADER_SIZE;
+  store_write_byte(store.end, STORE_FREE);
+
+  for (key = 1; key < STORE_KEYS; key++) {
+    if (index[key] != 0) {
+      store_append(key, NULL, index[key] + 2, store_read_byte(index[key] + 1));
+    }
+  }
+
+  store.gen++;
+  store_write_byte(to + STORE_GEN, store.gen);
+  store_write_byte(to + STORE_MAGIC_OFFSET, STORE_MAGIC);
+  store_write_byte(from + STORE_MAGIC_OFFSET, 0);
+}
+
+/**
+ * @brief   Makes room for a record at the end of the log.
+ * @note    The live records are compacted into the other bank when the
+ *          active one is full. The previous record of @p key is only
+ *          dropped when it does not fit with the new one, a power loss
+ *          before the new record is complete keeps it otherwise.
+ *
+ * @param[in] key   record key
+ * @param[in] n     payload length
+ * @return          false if the live records and the new one do not fit.
+ */
+static bool store_reserve(uint8_t key, uint8_t n) {
+  uint16_t live = STORE_HEADER_SIZE;
+  uint16_t old = 0;
+  uint8_t k;
+
+  if ((store.end + STORE_OVERHEAD + n) <= (store.base + STORE_BANK_SIZE))
+    return true;
+
+  for (k = 1; k < STORE_KEYS; k++) {
+    if ((k != key) && (store.index[k] != 0))
+      live += STORE_OVERHEAD + store_read_byte(store.index[k] + 1);
+  }
+  if ((live + STORE_OVERHEAD + n) > STORE_BANK_SIZE)
+    return false;
+
+  if (store.index[key] != 0)
+    old = STORE_OVERHEAD + store_read_byte(store.index[key] + 1);
+  if ((live + old + STORE_OVERHEAD + n) > STORE_BANK_SIZE)
+    store.index[key] = 0;
+  store_compact();
+
+  return true;
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Finds the active bank and indexes its records.
+ * @note    A blank EEPROM is formatted.
+ */
+void storeInit(void) {
+  bool valid0 = store_bank_is_valid(0);
+  bool valid1 = store_bank_is_valid(STORE_BANK_SIZE);
+  uint8_t gen0 = store_read_byte(STORE_GEN);
+  uint8_t gen1 = store_read_byte(STORE_BANK_SIZE + STORE_GEN);
+
+  chMtxObjectInit(&store.mtx);
+  store.key = 0;
+
+  if (valid0 && valid1) {
+    /* Generations wrap around, compares their distance.*/
+    store.base = ((int8_t)(gen1 - gen0) > 0) ? STORE_BANK_SIZE : 0;
+  }
+  else if (valid0 || valid1) {
+    store.base = valid0 ? 0 : STORE_BANK_SIZE;
+  }
+  else {
+    store_write_byte(STORE_HEADER_SIZE, STORE_FREE);
+    store_write_byte(STORE_GEN, 0);
+    store_write_byte(STORE_MAGIC_OFFSET, STORE_MAGIC);
+    store.base = 0;
+  }
+
+  store.gen = store_read_byte(store.base + STORE_GEN);
+  store_scan();
+}
+
+/**
+ * @brief   Returns the payload length of a key.
+ *
+ * @param[in] key   record key
+ * @return          the payload length, -1 if the key is not stored.
+ */
+int16_t storeGetSize(uint8_t key) {
+  int16_t size = -1;
+
+  if ((key == 0) || (key >= STORE_KEYS))
+    return -1;
+
+  chMtxLock(&store.mtx);
+  if (store.index[key] != 0)
+    size = store_read_byte(store.index[key] + 1);
+  chMtxUnlock(&store.mtx);
+
+  return size;
+}
+
+/**
+ * @brief   Reads a part of the payload of a key.
+ *
+ * @param[in] key       record key
+ * @param[in] offset    first payload byte to read
+ * @param[out] buf      destination buffer
+ * @param[in] n         maximum number of bytes to read
+ * @return              the number of bytes read, -1 if the key is not
+ *                      stored.
+ */
+int16_t storeRead(uint8_t key, uint8_t offset, void *buf, uint8_t n) {
+  uint8_t *p = buf;
+  uint16_t addr;
+  uint8_t len, i;
+
+  if ((key == 0) || (key >= STORE_KEYS))
+    return -1;
+
+  chMtxLock(&store.mtx);
+  addr = store.index[key];
+  if (addr == 0) {
+    chMtxUnlock(&store.mtx);
+    return -1;
+  }
+
+  len = store_read_byte(addr + 1);
+  if (offset >= len)
+    n = 0;
+  else if (n > (len - offset))
+    n = len - offset;
+
+  for (i = 0; i < n; i++)
+    p[i] = store_read_byte(addr + 2 + offset + i);
+  chMtxUnlock(&store.mtx);
+
+  return n;
+}
+
+/**
+ * @brief   Stores a new payload for a key.
+ * @note    Blocks the caller while the EEPROM is written, a few ms per byte.
+ *          Writing the payload already stored does nothing.
+ * @note    Refused while a record is written by parts, unless no part came
+ *          for @p STORE_PART_TIMEOUT: a client which died during an upload
+ *          does not block the store, its record is dropped.
+ *
+ * @param[in] key   record key
+ * @param[in] buf   payload
+ * @param[in] n     payload length
+ * @return          false if the key is invalid, a record is written by
+ *                  parts or the data does not fit.
+ */
+bool storeWrite(uint8_t key, const void *buf, uint8_t n) {
+  const uint8_t *p = buf;
+  uint16_t addr;
+  uint8_t i;
+
+  if ((key == 0) || (key >= STORE_KEYS))
+    return false;
+
+  chMtxLock(&store.mtx);
+  if (store.key != 0) {
+    if ((systime_t)(chVTGetSystemTimeX() - store.stamp) < STORE_PART_TIMEOUT) {
+      chMtxUnlock(&store.mtx);
+      return false;
+    }
+    /* Its key byte is still free, the record is simply forgotten.*/
+    store.key = 0;
+  }
+
+  /* Same payload as the stored one, saves the EEPROM.*/
+  addr = store.index[key];
+  if ((addr != 0) && (store_read_byte(addr + 1) == n)) {
+    for (i = 0; i < n; i++) {
+      if (store_read_byte(addr + 2 + i) != p[i])
+        break;
+    }
+    if (i == n) {
+      chMtxUnlock(&store.mtx);
+      return true;
+    }
+  }
+
+  if (!store_reserve(key, n)) {
+    chMtxUnlock(&store.mtx);
+    return false;
+  }
+
+  store_append(key, p, 0, n);
+  chMtxUnlock(&store.mtx);
+
+  return true;
+}
+
+/**
+ * @brief   Starts writing a record by parts.
+ * @details Large payloads, like animations uploaded on the serial port, go
+ *          straight to the EEPROM without being buffered in RAM. Unless
+ *          the log had to be compacted to make room, the previous record
+ *          of the key stays valid until @p storeWriteEnd().
+ * @note    A record by parts left incomplete is dropped, the upload of a
+ *          client which died is replaced by the next one.
+ *
+ * @param[in] key   record key
+ * @param[in] n     payload length
+ * @return          false if the key is invalid or the data does not fit.
+ */
+bool storeWriteBegin(uint8_t key, uint8_t n) {
+  bool ok;
+
+  if ((key == 0) || (key >= STORE_KEYS))
+    return false;
+
+  chMtxLock(&store.mtx);
+  store.key = 0;
+  ok = store_reserve(key, n);
+  if (ok) {
+    store.key   = key;
+    store.len   = n;
+    store.pos   = 0;
+    store.stamp = chVTGetSystemTimeX();
+    store.crc = _crc8_ccitt_update(_crc8_ccitt_update(0, key), n);
+    store_write_byte(store.end + 1, n);
+  }
+  chMtxUnlock(&store.mtx);
+
+  return ok;
+}
+
+/**
+ * @brief   Writes the next part of the record started by
+ *          @p storeWriteBegin().
+ *
+ * @param[in] buf   payload part
+ * @param[in] n     part length
+ * @return          false if no record is started or the part overflows
+ *                  its payload.
+ */
+bool storeWriteData(const void *buf, uint8_t n) {
+  const uint8_t *p = buf;
+  bool ok;
+
+  chMtxLock(&store.mtx);
+  ok = (store.key != 0) && (n <= (uint8_t)(store.len - store.pos));
+  if (ok) {
+    while (n-- > 0) {
+      store.crc = _crc8_ccitt_update(store.crc, *p);
+      store_write_byte(store.end + 2 + store.pos++, *p++);
+    }
+    store.stamp = chVTGetSystemTimeX();
+  }
+  chMtxUnlock(&store.mtx);
+
+  return ok;
+}
+
+/**
+ * @brief   Completes the record started by @p storeWriteBegin().
+ * @note    An incomplete record is dropped.
+ *
+ * @return  false if no record is started or its payload is incomplete.
+ */
+bool storeWriteEnd(void) {
+  uint16_t addr, next;
+  bool ok;
+
+  chMtxLock(&store.mtx);
+  addr = store.end;
+  ok = (store.key != 0) && (store.pos == store.len);
+  if (ok) {
+    next = addr + STORE_OVERHEAD + store.len;
+    store_write_byte(addr + 2 + store.len, store.crc);
+    if (next < (store.base + STORE_BANK_SIZE))
+      store_write_byte(next, STORE_FREE);
+    store_write_byte(addr, store.key);
+    store.index[store.key] = addr;
+    store.end = next;
+  }
+  store.key = 0;
+  chMtxUnlock(&store.mtx);
+
+  return ok;
+}
+
+/**
+ * @brief   Returns the generation of the active bank.
+ * @details It is incremented each time the log is compacted, it tells how
+ *          much the EEPROM has been used.
+ *
+ * @return  the generation number.
+ */
+uint8_t storeGetGeneration(void) {
+
+  return store.gen;
+}
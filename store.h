@@ -0,0 +1,67 @@
+/**
+ *
+ * @file    store.h
+ *
+ * @brief   Led cube persistent store header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _STORE_H_
+#define _STORE_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Number of keys, valid keys go from 1 to @p STORE_KEYS - 1.
+ */
+#if !defined(STORE_KEYS)
+#define STORE_KEYS                16
+#endif
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Size of the EEPROM.
+ */
+#define STORE_SIZE                (E2END + 1)
+
+/**
+ * @brief   Largest payload of a record.
+ */
+#define STORE_MAX_PAYLOAD         255
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void storeInit(void);
+  int16_t storeGetSize(uint8_t key);
+  int16_t storeRead(uint8_t key, uint8_t offset, void *buf, uint8_t n);
+  bool storeWrite(uint8_t key, const void *buf, uint8_t n);
+  bool storeWriteBegin(uint8_t key, uint8_t n);
+  bool storeWriteData(const void *buf, uint8_t n);
+  bool storeWriteEnd(void);
+  uint8_t storeGetGeneration(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _STORE_H_ */
@@ -0,0 +1,169 @@
+/**
+ *
+ * @file    sync.c
+ *
+ * @brief   Led cube multi cubes synchronization source file.
+ *
+ * @details Each tick makes the followers step their animation and restart
+ *          their layer scan at the same time as the master, the cubes are
+ *          phase locked on the master steps. A follower which misses a tick
+ *          steps on its own after one and a half step period.
+ *          A follower joining in the middle of an animation with a state,
+ *          like the rain, shows the same frames from the next start of the
+ *          animation on. The demo of the ledcube driver is not synchronized.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <util/crc16.h>
+
+/* Project local files. */
+#include "display.h"
+#include "anim.h"
+#include "sio.h"
+#include "sync.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Synchronization state.
+ */
+static struct {
+  /* Role of this cube.*/
+  uint8_t       role;
+  /* Animation of the last tick.*/
+  uint8_t       id;
+  /* Step expected in the next tick.*/
+  uint16_t      next;
+  /* Follower statistics.*/
+  sync_stats_t  stats;
+} sync;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+static uint8_t sync_crc(const uint8_t *p) {
+  uint8_t crc = 0;
+  uint8_t i;
+
+  for (i = 0; i < (SYNC_TICK_SIZE - 1); i++)
+    crc = _crc8_ccitt_update(crc, p[i]);
+
+  return crc;
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Sets the role of this cube.
+ *
+ * @param[in] role  @p SYNC_NONE, @p SYNC_MASTER or @p SYNC_FOLLOWER
+ */
+void syncSetRole(uint8_t role) {
+
+  if (role <= SYNC_FOLLOWER)
+    sync.role = role;
+}
+
+/**
+ * @brief   Returns the role of this cube.
+ *
+ * @return  the role.
+ */
+uint8_t syncGetRole(void) {
+
+  return sync.role;
+}
+
+/**
+ * @brief   Sends a tick, called by the master after each step.
+ * @note    The tick is dropped rather than delaying the animation.
+ *
+ * @param[in] id    animation identifier
+ * @param[in] step  step just played
+ */
+void syncSendTick(uint8_t id, uint16_t step) {
+  uint8_t msg[SYNC_TICK_SIZE];
+
+  msg[0] = SYNC_TICK;
+  msg[1] = id;
+  msg[2] = (uint8_t)step;
+  msg[3] = (uint8_t)(step >> 8);
+  msg[4] = sync_crc(msg);
+
+  displayResync();
+  (void)sioWrite(msg, SYNC_TICK_SIZE, TIME_IMMEDIATE);
+}
+
+/**
+ * @brief   Receives a tick and follows it.
+ * @note    Called once the @p SYNC_TICK byte has been read, ticks are
+ *          ignored when this cube is not a follower.
+ *
+ * @param[in] chp   channel the tick comes from
+ * @return          false if the tick was incomplete or its CRC wrong.
+ */
+bool syncReceive(BaseChannel *chp) {
+  uint8_t msg[SYNC_TICK_SIZE];
+  uint16_t step;
+  uint16_t error;
+  int16_t late, gap;
+
+  msg[0] = SYNC_TICK;
+  if ((chnReadTimeout(chp, &msg[1], SYNC_TICK_SIZE - 1, MS2ST(10)) !=
+       (SYNC_TICK_SIZE - 1)) || (sync_crc(msg) != msg[4]))
+    return false;
+  if (sync.role != SYNC_FOLLOWER)
+    return true;
+
+  step = msg[2] | (msg[3] << 8);
+
+  displayResync();
+  late = animFollow(msg[1], step);
+
+  /* The first tick and the ticks after a gap have no reference. A new
+     animation or a step going backwards, the master restarted, resyncs
+     without counting lost ticks.*/
+  gap = (int16_t)(step - sync.next);
+  if ((sync.stats.ticks > 0) && (msg[1] == sync.id) && (gap >= 0)) {
+    if (gap > 0) {
+      sync.stats.lost += (uint16_t)gap;
+    }
+    else {
+      error = (late < 0) ? -late : late;
+      sync.stats.error = late;
+      if (error > sync.stats.max_error)
+        sync.stats.max_error = error;
+    }
+  }
+  sync.stats.ticks++;
+  sync.id   = msg[1];
+  sync.next = step + 1;
+
+  (void)sioWrite(msg, SYNC_TICK_SIZE, TIME_IMMEDIATE);
+
+  return true;
+}
+
+/**
+ * @brief   Returns the follower statistics.
+ *
+ * @param[out] sp   statistics
+ */
+void syncGetStats(sync_stats_t *sp) {
+
+  *sp = sync.stats;
+}
@@ -0,0 +1,87 @@
+/**
+ *
+ * @file    sync.h
+ *
+ * @brief   Led cube multi cubes synchronization header file.
+ *
+ * @details The master cube sends a tick message after each animation step:
+ *          @p SYNC_TICK, animation (1 byte), step number (2 bytes, little
+ *          endian), CRC8 of the previous bytes (1 byte).
+ *          A follower plays the same step of the same animation as soon as
+ *          it receives the message, then relays it on its own serial
+ *          output for the next cube of the chain.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _SYNC_H_
+#define _SYNC_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   First byte of a tick message.
+ */
+#define SYNC_TICK                 0xA6
+
+/**
+ * @brief   Size of a tick message.
+ */
+#define SYNC_TICK_SIZE            5
+
+/**
+ * @name    Roles
+ * @{
+ */
+#define SYNC_NONE                 0
+#define SYNC_MASTER               1
+#define SYNC_FOLLOWER             2
+/** @} */
+
+/*==========================================================================*/
+/* Data structures and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Synchronization statistics of a follower.
+ */
+typedef struct {
+  /* Ticks received.*/
+  uint16_t  ticks;
+  /* Ticks missed, deduced from the gaps in the step numbers.*/
+  uint16_t  lost;
+  /* Last and worst distance between a tick and the local step time.*/
+  int16_t   error;
+  uint16_t  max_error;
+} sync_stats_t;
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void syncSetRole(uint8_t role);
+  uint8_t syncGetRole(void);
+  void syncSendTick(uint8_t id, uint16_t step);
+  bool syncReceive(BaseChannel *chp);
+  void syncGetStats(sync_stats_t *sp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SYNC_H_ */
@@ -0,0 +1,238 @@
+/**
+ *
+ * @file    telemetry.c
+ *
+ * @brief   Led cube telemetry stream source file.
+ *
+ * @details The counters are sampled by the animation thread after a step,
+ *          a record is queued without waiting: it is dropped when the
+ *          output queue is full, the refresh is never delayed.
+ *          The stack usage relies on @p CH_DBG_FILL_THREADS.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <util/crc16.h>
+
+/* Project local files. */
+#include "display.h"
+#include "anim.h"
+#include "power.h"
+#include "sio.h"
+#include "telemetry.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   SD1 errors counted as receive overruns.
+ * @note    This HAL reports a full input queue as an overrun, later ones
+ *          have a flag of its own.
+ */
+#if defined(SD_QUEUE_FULL_ERROR)
+#define TELEMETRY_RX_ERRORS       (SD_OVERRUN_ERROR | SD_QUEUE_FULL_ERROR)
+#else
+#define TELEMETRY_RX_ERRORS       SD_OVERRUN_ERROR
+#endif
+
+/* A record is only queued when all of it fits in the output queue.*/
+#if TELEMETRY_SIZE > SERIAL_BUFFERS_SIZE
+#error "a telemetry record must fit in the SD1 output queue"
+#endif
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Telemetry state.
+ */
+static struct {
+  /* Frames per record, zero when disabled.*/
+  uint8_t           period;
+  /* Frames played since the last record.*/
+  uint8_t           frames;
+  /* Sequence number of the next record.*/
+  uint8_t           seq;
+  /* Receive overruns.*/
+  uint8_t           overruns;
+  /* Time covered by the next record.*/
+  uint32_t          elapsed;
+  systime_t         last;
+  /* Scans and missed deadlines at the last record.*/
+  uint16_t          scans;
+  uint16_t          anim_missed;
+  uint16_t          refresh_missed;
+  /* Listener of the SD1 errors.*/
+  event_listener_t  el;
+  bool              listening;
+} telemetry;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Returns the bytes of a thread stack never used.
+ * @note    Only valid for threads created in a working area, the stack
+ *          grows down to the thread descriptor at its base.
+ *
+ * @param[in] tp    thread
+ */
+static uint8_t telemetry_stack_free(thread_t *tp) {
+  const uint8_t *p = (const uint8_t *)(tp + 1);
+  uint8_t n = 0;
+
+  while ((*p++ == CH_DBG_STACK_FILL_VALUE) && (n < 0xFF))
+    n++;
+
+  return n;
+}
+
+/**
+ * @brief   Returns the increase of a counter since the previous record,
+ *          saturated to a byte.
+ *
+ * @param[in] count     counter
+ * @param[in,out] last  counter at the previous record
+ */
+static uint8_t telemetry_delta(uint16_t count, uint16_t *last) {
+  uint16_t delta = count - *last;
+
+  *last = count;
+  return (delta > 0xFF) ? 0xFF : (uint8_t)delta;
+}
+
+/**
+ * @brief   Sends a record.
+ */
+static void telemetry_send(void) {
+  display_stats_t refresh;
+  anim_stats_t anim;
+  uint8_t rec[TELEMETRY_SIZE];
+  uint16_t ms, scans;
+  uint8_t i, crc = 0;
+
+  chSysLock();
+  displayGetStatsI(&refresh);
+  animGetStatsI(&anim);
+  chSysUnlock();
+
+  if (telemetry.elapsed > (60UL * CH_CFG_ST_FREQUENCY))
+    telemetry.elapsed = 60UL * CH_CFG_ST_FREQUENCY;
+  ms = (uint16_t)((telemetry.elapsed * 1000UL) / CH_CFG_ST_FREQUENCY);
+  scans = refresh.scans - telemetry.scans;
+  telemetry.scans = refresh.scans;
+
+  rec[0]  = TELEMETRY_RECORD;
+  rec[1]  = telemetry.seq++;
+  rec[2]  = (uint8_t)ms;
+  rec[3]  = (uint8_t)(ms >> 8);
+  rec[4]  = telemetry.frames;
+  rec[5]  = (uint8_t)scans;
+  rec[6]  = (uint8_t)(scans >> 8);
+  rec[7]  = telemetry_delta(anim.missed, &telemetry.anim_missed);
+  rec[8]  = telemetry_delta(refresh.missed, &telemetry.refresh_missed);
+  rec[9]  = refresh.isr_max;
+  rec[10] = powerGetIdlePercent();
+  rec[11] = telemetry.overruns;
+  rec[12] = telemetry_stack_free(chThdGetSelfX());
+  rec[13] = telemetry_stack_free(chSysGetIdleThreadX());
+  for (i = 0; i < (TELEMETRY_SIZE - 1); i++)
+    crc = _crc8_ccitt_update(crc, rec[i]);
+  rec[TELEMETRY_SIZE - 1] = crc;
+
+  (void)sioWrite(rec, TELEMETRY_SIZE, TIME_IMMEDIATE);
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Enables or disables the telemetry.
+ *
+ * @param[in] frames    animation frames per record, zero disables it
+ */
+void telemetrySetPeriod(uint8_t frames) {
+
+  chSysLock();
+  telemetry.period = frames;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Counts a frame and sends a record when its period is over.
+ * @note    Called by the animation thread after each step.
+ */
+void telemetryStep(void) {
+  systime_t now = chVTGetSystemTime();
+
+  /* The listener belongs to the thread registering it.*/
+  if (!telemetry.listening) {
+    chEvtRegisterMaskWithFlags(chnGetEventSource(&SD1), &telemetry.el,
+                               EVENT_MASK(0), TELEMETRY_RX_ERRORS);
+    telemetry.listening = true;
+    telemetry.last = now;
+  }
+  if ((chEvtGetAndClearFlags(&telemetry.el) != 0) &&
+      (telemetry.overruns < 0xFF))
+    telemetry.overruns++;
+
+  telemetry.elapsed += now - telemetry.last;
+  telemetry.last = now;
+
+  if (telemetry.period == 0) {
+    display_stats_t refresh;
+    anim_stats_t anim;
+
+    /* The first record starts from the frame enabling it.*/
+    chSysLock();
+    displayGetStatsI(&refresh);
+    animGetStatsI(&anim);
+    chSysUnlock();
+    telemetry.scans          = refresh.scans;
+    telemetry.anim_missed    = anim.missed;
+    telemetry.refresh_missed = refresh.missed;
+    telemetry.frames  = 0;
+    telemetry.elapsed = 0;
+    return;
+  }
+
+  if (++telemetry.frames >= telemetry.period) {
+    telemetry_send();
+    telemetry.frames  = 0;
+    telemetry.elapsed = 0;
+  }
+}
+
+/**
+ * @brief   Drops a record sent by the previous cube of a chain.
+ * @note    Called once the @p TELEMETRY_RECORD byte has been read.
+ *
+ * @param[in] chp   channel the record comes from
+ * @return          false if the record was incomplete or its CRC wrong.
+ */
+bool telemetryReceive(BaseChannel *chp) {
+  uint8_t rec[TELEMETRY_SIZE];
+  uint8_t i, crc = 0;
+
+  rec[0] = TELEMETRY_RECORD;
+  if (chnReadTimeout(chp, &rec[1], TELEMETRY_SIZE - 1, MS2ST(10)) !=
+      (TELEMETRY_SIZE - 1))
+    return false;
+
+  for (i = 0; i < (TELEMETRY_SIZE - 1); i++)
+    crc = _crc8_ccitt_update(crc, rec[i]);
+
+  return crc == rec[TELEMETRY_SIZE - 1];
+}
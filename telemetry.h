@@ -0,0 +1,68 @@
+/**
+ *
+ * @file    telemetry.h
+ *
+ * @brief   Led cube telemetry stream header file.
+ *
+ * @details When enabled, a record is sent on SD1 every few animation
+ *          frames, all little endian:
+ *          - 0xA7, sequence number (1 byte),
+ *          - time covered by the record, in ms (2 bytes),
+ *          - animation frames (1 byte) and layer scans (2 bytes) played,
+ *          - animation and refresh deadlines missed since the previous
+ *            record, up to 255 (1 byte each),
+ *          - longest scan timer event since boot, in F_CPU / 8 cycles
+ *            (1 byte),
+ *          - idle time, in percent (1 byte),
+ *          - receive overruns since boot (1 byte),
+ *          - bytes never used on the stacks of the animation thread and of
+ *            the idle thread (1 byte each),
+ *          - CRC-8 of the previous bytes.
+ *          .
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   First byte of a telemetry record.
+ */
+#define TELEMETRY_RECORD          0xA7
+
+/**
+ * @brief   Size of a telemetry record.
+ */
+#define TELEMETRY_SIZE            15
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void telemetrySetPeriod(uint8_t frames);
+  void telemetryStep(void);
+  bool telemetryReceive(BaseChannel *chp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TELEMETRY_H_ */
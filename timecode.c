@@ -0,0 +1,75 @@
+/**
+ *
+ * @file    timecode.c
+ *
+ * @brief   Led cube show control timecode source file.
+ *
+ * @details Each valid timecode seeks the animations to the same time, they
+ *          are only moved when they are more than one frame away from it.
+ *          Without timecode the animations run on their own.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <util/crc16.h>
+
+/* Project local files. */
+#include "anim.h"
+#include "sio.h"
+#include "timecode.h"
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+static uint8_t timecode_crc(const uint8_t *p) {
+  uint8_t crc = 0;
+  uint8_t i;
+
+  for (i = 0; i < (TIMECODE_FRAME_SIZE - 1); i++)
+    crc = _crc8_ccitt_update(crc, p[i]);
+
+  return crc;
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Receives a timecode and seeks the animations to it.
+ * @note    Called once the @p TIMECODE_FRAME byte has been read, invalid
+ *          messages are dropped.
+ *
+ * @param[in] chp   channel the timecode comes from
+ * @return          false if the timecode was incomplete or its CRC wrong.
+ */
+bool timecodeReceive(BaseChannel *chp) {
+  uint8_t msg[TIMECODE_FRAME_SIZE];
+  uint32_t ms;
+
+  msg[0] = TIMECODE_FRAME;
+  if ((chnReadTimeout(chp, &msg[1], TIMECODE_FRAME_SIZE - 1, MS2ST(10)) !=
+       (TIMECODE_FRAME_SIZE - 1)) || (timecode_crc(msg) != msg[5]))
+    return false;
+
+  if ((msg[1] > 23) || (msg[2] > 59) || (msg[3] > 59) ||
+      (msg[4] >= TIMECODE_FPS))
+    return true;
+
+  ms = ((((uint32_t)msg[1] * 60) + msg[2]) * 60 + msg[3]) * 1000 +
+       ((uint16_t)msg[4] * 1000) / TIMECODE_FPS;
+  animSeek(ms);
+
+  (void)sioWrite(msg, TIMECODE_FRAME_SIZE, TIME_IMMEDIATE);
+
+  return true;
+}
@@ -0,0 +1,77 @@
+/**
+ *
+ * @file    timecode.h
+ *
+ * @brief   Led cube show control timecode header file.
+ *
+ * @details A show controller sends a timecode message at each of its
+ *          frames: @p TIMECODE_FRAME, hours, minutes, seconds and frames
+ *          (1 byte each), CRC8 of the previous bytes (1 byte).
+ *          The timecode is the time since the start of the playlist, or of
+ *          the selected animation when there is no playlist. The cube
+ *          relays the message on its serial output for the next cube of a
+ *          chain.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _TIMECODE_H_
+#define _TIMECODE_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   First byte of a timecode message.
+ */
+#define TIMECODE_FRAME            0xA8
+
+/**
+ * @brief   Size of a timecode message.
+ */
+#define TIMECODE_FRAME_SIZE       6
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Frames per second of the timecode.
+ */
+#if !defined(TIMECODE_FPS)
+#define TIMECODE_FPS              25
+#endif
+
+/*==========================================================================*/
+/* Derived constants and error checks.                                      */
+/*==========================================================================*/
+
+#if (TIMECODE_FPS < 1) || (TIMECODE_FPS > 100)
+#error "TIMECODE_FPS must be between 1 and 100"
+#endif
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  bool timecodeReceive(BaseChannel *chp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TIMECODE_H_ */
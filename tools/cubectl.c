@@ -0,0 +1,262 @@
+/**
+ *
+ * @file    cubectl.c
+ *
+ * @brief   Led cube command line client.
+ *
+ * @details Drives a cube with the binary commands of rpc.h through the
+ *          cuberpc library.
+ *
+ *          Usage: cubectl [-p port] command [arguments]
+ *          - anim [id], brightness [value], period [ticks]: sets the value,
+ *            or prints it without argument,
+ *          - text [characters]: scrolls the text, none goes back to the
+ *            demo,
+ *          - show file: uploads the stored animation,
+ *          - playlist [id:seconds...]: plays the list, none stops it,
+ *          - stat id: prints a statistic,
+ *          - sync role: 0 none, 1 master, 2 follower,
+ *          - telemetry frames: 0 stops the stream,
+ *          - ping [count]: measures the round trip of the requests, the
+ *            latency benchmark, on a cube or a pseudo terminal.
+ *          .
+ *          The port is $CUBE_PORT, /dev/ttyACM0 by default. The exit status
+ *          is 1 when the cube answered an error or did not answer, 2 on a
+ *          usage error.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Local files. */
+#include "cuberpc.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Usage message.
+ */
+#define USAGE \
+  "usage: cubectl [-p port] anim|brightness|period|text|show|playlist|\n" \
+  "               stat|sync|telemetry|ping [arguments]\n"
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Prints a failed call.
+ *
+ * @return  1 if the call failed, 0 otherwise.
+ */
+static int check(const char *what, int status) {
+
+  if (status == CUBE_OK)
+    return 0;
+  if (status == CUBE_RPC_NO_RESPONSE)
+    fprintf(stderr, "%s: no response\n", what);
+  else
+    fprintf(stderr, "%s: error %d\n", what, status);
+
+  return 1;
+}
+
+/**
+ * @brief   Sets a value, or prints it without argument.
+ */
+static int set_or_get(int fd, const char *what, uint8_t set, uint8_t get,
+                      int argc, char **argv) {
+  uint8_t data[CUBE_RPC_DATA_SIZE] = {0};
+  long value;
+
+  if (argc > 0) {
+    value = strtol(argv[0], NULL, 0);
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    return check(what, cubeCall(fd, set, data, NULL));
+  }
+
+  if (check(what, cubeCall(fd, get, NULL, data)))
+    return 1;
+  printf("%u\n", data[0] | (data[1] << 8));
+
+  return 0;
+}
+
+/**
+ * @brief   Uploads a stored animation file.
+ */
+static int show(int fd, const char *path) {
+  uint8_t buf[256];
+  FILE *f;
+  size_t n;
+
+  if ((f = fopen(path, "rb")) == NULL) {
+    perror(path);
+    return 1;
+  }
+  n = fread(buf, 1, sizeof(buf), f);
+  fclose(f);
+  if (n > 255) {
+    fprintf(stderr, "%s: longer than 255 bytes\n", path);
+    return 1;
+  }
+
+  return check("show", cubeUploadShow(fd, buf, n));
+}
+
+/**
+ * @brief   Sends then plays a playlist of id:seconds entries.
+ */
+static int playlist(int fd, int argc, char **argv) {
+  uint8_t data[CUBE_RPC_DATA_SIZE] = {0};
+  unsigned id, seconds;
+  int i;
+
+  for (i = 0; i < argc; i++) {
+    if (sscanf(argv[i], "%u:%u", &id, &seconds) != 2) {
+      fprintf(stderr, "%s: expected id:seconds\n", argv[i]);
+      return 2;
+    }
+    data[0] = (uint8_t)i;
+    data[1] = (uint8_t)id;
+    data[2] = (uint8_t)seconds;
+    if (check("playlist", cubeCall(fd, CUBE_CMD_PLAYLIST, data, NULL)))
+      return 1;
+  }
+
+  memset(data, 0, sizeof(data));
+  data[0] = (uint8_t)argc;
+  return check("playlist", cubeCall(fd, CUBE_CMD_PLAYLIST_COMMIT, data, NULL));
+}
+
+/**
+ * @brief   Measures the round trip of ping requests.
+ */
+static int ping(int fd, long count) {
+  uint8_t data[CUBE_RPC_DATA_SIZE], echo[CUBE_RPC_DATA_SIZE];
+  struct timespec t0, t1;
+  double us, min = 0, max = 0, sum = 0;
+  long i, lost = 0;
+
+  for (i = 0; i < count; i++) {
+    memcpy(data, &i, sizeof(data));
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if ((cubeCall(fd, CUBE_CMD_PING, data, echo) != CUBE_OK) ||
+        (memcmp(data, echo, sizeof(data)) != 0)) {
+      lost++;
+      continue;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    us = ((t1.tv_sec - t0.tv_sec) * 1e6) + ((t1.tv_nsec - t0.tv_nsec) / 1e3);
+    if ((sum == 0) || (us < min))
+      min = us;
+    if (us > max)
+      max = us;
+    sum += us;
+  }
+
+  printf("%ld requests, %ld lost", count, lost);
+  if (lost < count)
+    printf(", round trip min %.0f avg %.0f max %.0f us", min,
+           sum / (count - lost), max);
+  printf("\n");
+
+  return (lost > 0) ? 1 : 0;
+}
+
+/**
+ * @brief   Runs a command.
+ */
+static int run(int fd, int argc, char **argv) {
+  uint8_t data[CUBE_RPC_DATA_SIZE] = {0};
+  uint32_t value;
+  const char *cmd = argv[0];
+
+  argc--;
+  argv++;
+  if (strcmp(cmd, "anim") == 0)
+    return set_or_get(fd, cmd, CUBE_CMD_SET_ANIM, CUBE_CMD_GET_ANIM,
+                      argc, argv);
+  if (strcmp(cmd, "brightness") == 0)
+    return set_or_get(fd, cmd, CUBE_CMD_SET_BRIGHTNESS,
+                      CUBE_CMD_GET_BRIGHTNESS, argc, argv);
+  if (strcmp(cmd, "period") == 0)
+    return set_or_get(fd, cmd, CUBE_CMD_SET_PERIOD, CUBE_CMD_GET_PERIOD,
+                      argc, argv);
+  if (strcmp(cmd, "text") == 0)
+    return check(cmd, cubeSetText(fd, (argc > 0) ? argv[0] : "",
+                                  (argc > 0) ? strlen(argv[0]) : 0));
+  if ((strcmp(cmd, "show") == 0) && (argc == 1))
+    return show(fd, argv[0]);
+  if (strcmp(cmd, "playlist") == 0)
+    return playlist(fd, argc, argv);
+  if ((strcmp(cmd, "stat") == 0) && (argc == 1)) {
+    data[0] = (uint8_t)strtol(argv[0], NULL, 0);
+    if (check(cmd, cubeCall(fd, CUBE_CMD_GET_STAT, data, data)))
+      return 1;
+    value = data[0] | (data[1] << 8) | ((uint32_t)data[2] << 16) |
+            ((uint32_t)data[3] << 24);
+    printf("%lu\n", (unsigned long)value);
+    return 0;
+  }
+  if (((strcmp(cmd, "sync") == 0) || (strcmp(cmd, "telemetry") == 0)) &&
+      (argc == 1)) {
+    data[0] = (uint8_t)strtol(argv[0], NULL, 0);
+    return check(cmd, cubeCall(fd, (cmd[0] == 's') ? CUBE_CMD_SET_SYNC :
+                                   CUBE_CMD_TELEMETRY, data, NULL));
+  }
+  if (strcmp(cmd, "ping") == 0)
+    return ping(fd, (argc > 0) ? atol(argv[0]) : 100);
+
+  fprintf(stderr, USAGE);
+  return 2;
+}
+
+/*
+ * Tool entry point.
+ */
+int main(int argc, char **argv) {
+  const char *port = getenv("CUBE_PORT");
+  int opt, fd, status;
+
+  if (port == NULL)
+    port = "/dev/ttyACM0";
+
+  while ((opt = getopt(argc, argv, "p:")) != -1) {
+    if (opt != 'p') {
+      fprintf(stderr, USAGE);
+      return 2;
+    }
+    port = optarg;
+  }
+  if (optind >= argc) {
+    fprintf(stderr, USAGE);
+    return 2;
+  }
+
+  if ((fd = cubeOpen(port)) < 0) {
+    perror(port);
+    return 2;
+  }
+  status = run(fd, argc - optind, &argv[optind]);
+  cubeClose(fd);
+
+  return status;
+}
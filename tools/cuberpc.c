@@ -0,0 +1,254 @@
+/**
+ *
+ * @file    cuberpc.c
+ *
+ * @brief   Led cube binary command client library source file.
+ *
+ * @details The port is opened raw at 38400 bauds. Each call sends one
+ *          request and reads bytes until the response which echoes its
+ *          command and sequence number, so the text and the binary records
+ *          also sent by the cube are skipped.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Local files. */
+#include "cuberpc.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Sequence number of the next request.
+ */
+static uint8_t cube_seq;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Returns the milliseconds of a monotonic clock.
+ */
+static long cube_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (ts.tv_sec * 1000L) + (ts.tv_nsec / 1000000L);
+}
+
+/**
+ * @brief   Reads one byte before a deadline.
+ *
+ * @return  the byte, -1 on time out or error.
+ */
+static int cube_getc(int fd, long deadline) {
+  struct pollfd pfd;
+  uint8_t c;
+  long left;
+
+  pfd.fd     = fd;
+  pfd.events = POLLIN;
+  while ((left = deadline - cube_now()) > 0) {
+    if (poll(&pfd, 1, (int)left) <= 0)
+      continue;
+    if (read(fd, &c, 1) == 1)
+      return c;
+    return -1;
+  }
+
+  return -1;
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Opens the serial port of a cube.
+ *
+ * @param[in] path  serial port or pseudo terminal
+ * @return          the file descriptor, -1 on error.
+ */
+int cubeOpen(const char *path) {
+  struct termios tio;
+  int fd;
+
+  if ((fd = open(path, O_RDWR | O_NOCTTY)) < 0)
+    return -1;
+
+  if (tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B38400);
+    cfsetospeed(&tio, B38400);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+    tcflush(fd, TCIOFLUSH);
+  }
+
+  return fd;
+}
+
+/**
+ * @brief   Closes the serial port of a cube.
+ */
+void cubeClose(int fd) {
+
+  close(fd);
+}
+
+/**
+ * @brief   Computes the CRC8 of a frame, polynomial 0x07.
+ *
+ * @param[in] p     bytes
+ * @param[in] n     number of bytes
+ * @return          the CRC.
+ */
+uint8_t cubeCrc(const uint8_t *p, size_t n) {
+  uint8_t crc = 0;
+  int i;
+
+  while (n-- > 0) {
+    crc ^= *p++;
+    for (i = 0; i < 8; i++)
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+  }
+
+  return crc;
+}
+
+/**
+ * @brief   Sends a request and waits for its response.
+ *
+ * @param[in] fd        serial port
+ * @param[in] cmd       command code
+ * @param[in] data      @p CUBE_RPC_DATA_SIZE bytes of data, NULL for zeros
+ * @param[out] result   @p CUBE_RPC_DATA_SIZE bytes of the response, may be
+ *                      NULL
+ * @return              the response status, @p CUBE_RPC_NO_RESPONSE if no
+ *                      valid response came within @p CUBE_RPC_TIMEOUT.
+ */
+int cubeCall(int fd, uint8_t cmd, const uint8_t *data, uint8_t *result) {
+  uint8_t req[CUBE_RPC_REQUEST_SIZE];
+  uint8_t resp[CUBE_RPC_RESPONSE_SIZE];
+  long deadline;
+  int c, n;
+
+  req[0] = CUBE_RPC_SYNC;
+  req[1] = cmd;
+  req[2] = cube_seq++;
+  if (data != NULL)
+    memcpy(&req[3], data, CUBE_RPC_DATA_SIZE);
+  else
+    memset(&req[3], 0, CUBE_RPC_DATA_SIZE);
+  req[7] = cubeCrc(req, sizeof(req) - 1);
+
+  if (write(fd, req, sizeof(req)) != (ssize_t)sizeof(req))
+    return CUBE_RPC_NO_RESPONSE;
+
+  deadline = cube_now() + CUBE_RPC_TIMEOUT;
+  n = 0;
+  while ((c = cube_getc(fd, deadline)) >= 0) {
+    if ((n == 0) && (c != CUBE_RPC_REPLY))
+      continue;
+    resp[n++] = (uint8_t)c;
+    if (n < (int)sizeof(resp))
+      continue;
+
+    if ((resp[1] == cmd) && (resp[2] == req[2]) &&
+        (cubeCrc(resp, sizeof(resp) - 1) == resp[8])) {
+      if (result != NULL)
+        memcpy(result, &resp[4], CUBE_RPC_DATA_SIZE);
+      return resp[3];
+    }
+
+    /* Not our response, looks for a reply byte after the false one.*/
+    for (n = 1; (n < (int)sizeof(resp)) && (resp[n] != CUBE_RPC_REPLY); n++)
+      ;
+    memmove(resp, &resp[n], sizeof(resp) - n);
+    n = sizeof(resp) - n;
+  }
+
+  return CUBE_RPC_NO_RESPONSE;
+}
+
+/**
+ * @brief   Sends a text in parts then scrolls it.
+ *
+ * @param[in] fd    serial port
+ * @param[in] text  characters, @p CUBE_TEXT_SIZE at most
+ * @param[in] n     number of characters, zero goes back to the demo
+ * @return          the status of the first failed request, @p CUBE_OK
+ *                  otherwise.
+ */
+int cubeSetText(int fd, const char *text, size_t n) {
+  uint8_t data[CUBE_RPC_DATA_SIZE];
+  size_t i;
+  int status;
+
+  if (n > CUBE_TEXT_SIZE)
+    return CUBE_ERR_ARG;
+
+  for (i = 0; i < n; i += 3) {
+    memset(data, ' ', sizeof(data));
+    /* The last part is moved back so it fits in the buffer of the cube.*/
+    data[0] = (uint8_t)((i + 3 <= CUBE_TEXT_SIZE) ? i : CUBE_TEXT_SIZE - 3);
+    memcpy(&data[1], &text[data[0]], (n - data[0] < 3) ? n - data[0] : 3);
+    if ((status = cubeCall(fd, CUBE_CMD_TEXT, data, NULL)) != CUBE_OK)
+      return status;
+  }
+
+  memset(data, 0, sizeof(data));
+  data[0] = (uint8_t)n;
+  return cubeCall(fd, CUBE_CMD_TEXT_COMMIT, data, NULL);
+}
+
+/**
+ * @brief   Uploads the stored animation, see show.h for its format.
+ *
+ * @param[in] fd    serial port
+ * @param[in] buf   animation
+ * @param[in] n     animation length, 255 bytes at most
+ * @return          the status of the first failed request, @p CUBE_OK
+ *                  otherwise.
+ */
+int cubeUploadShow(int fd, const uint8_t *buf, size_t n) {
+  uint8_t data[CUBE_RPC_DATA_SIZE];
+  size_t i;
+  int status;
+
+  if (n > 255)
+    return CUBE_ERR_ARG;
+
+  memset(data, 0, sizeof(data));
+  data[0] = (uint8_t)n;
+  if ((status = cubeCall(fd, CUBE_CMD_SHOW_BEGIN, data, NULL)) != CUBE_OK)
+    return status;
+
+  for (i = 0; i < n; i += 3) {
+    data[0] = (uint8_t)((n - i < 3) ? n - i : 3);
+    memcpy(&data[1], &buf[i], data[0]);
+    if ((status = cubeCall(fd, CUBE_CMD_SHOW_DATA, data, NULL)) != CUBE_OK)
+      return status;
+  }
+
+  return cubeCall(fd, CUBE_CMD_SHOW_END, NULL, NULL);
+}
@@ -0,0 +1,110 @@
+/**
+ *
+ * @file    cuberpc.h
+ *
+ * @brief   Led cube binary command client library header file.
+ *
+ * @details Sends the requests described in rpc.h to a cube on a serial port
+ *          of a Linux host, or on a pseudo terminal, and waits for their
+ *          responses. The command codes and the statuses are the ones of
+ *          rpc.h.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _CUBERPC_H_
+#define _CUBERPC_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stddef.h>
+#include <stdint.h>
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @name    Frame layout, see rpc.h
+ * @{
+ */
+#define CUBE_RPC_SYNC             0xA5
+#define CUBE_RPC_REPLY            0xA4
+#define CUBE_RPC_DATA_SIZE        4
+#define CUBE_RPC_REQUEST_SIZE     8
+#define CUBE_RPC_RESPONSE_SIZE    9
+/** @} */
+
+/**
+ * @name    Commands, see rpc.h for their data
+ * @{
+ */
+#define CUBE_CMD_PING             0x00
+#define CUBE_CMD_SET_ANIM         0x01
+#define CUBE_CMD_GET_ANIM         0x02
+#define CUBE_CMD_SET_BRIGHTNESS   0x03
+#define CUBE_CMD_GET_BRIGHTNESS   0x04
+#define CUBE_CMD_SET_PERIOD       0x05
+#define CUBE_CMD_GET_PERIOD       0x06
+#define CUBE_CMD_TEXT             0x07
+#define CUBE_CMD_TEXT_COMMIT      0x08
+#define CUBE_CMD_SHOW_BEGIN       0x09
+#define CUBE_CMD_SHOW_DATA        0x0A
+#define CUBE_CMD_SHOW_END         0x0B
+#define CUBE_CMD_PLAYLIST         0x0C
+#define CUBE_CMD_PLAYLIST_COMMIT  0x0D
+#define CUBE_CMD_GET_STAT         0x0E
+#define CUBE_CMD_SET_SYNC         0x0F
+#define CUBE_CMD_TELEMETRY        0x10
+/** @} */
+
+/**
+ * @name    Response status
+ * @{
+ */
+#define CUBE_OK                   0x00
+#define CUBE_ERR_CMD              0x01
+#define CUBE_ERR_ARG              0x02
+#define CUBE_ERR_FAIL             0x03
+#define CUBE_ERR_CRC              0x04
+/** @} */
+
+/**
+ * @brief   Longest text scrolled by the cube, see scroll.h
+ */
+#define CUBE_TEXT_SIZE            32
+
+/**
+ * @brief   Time allowed to the cube to answer, in milliseconds.
+ */
+#define CUBE_RPC_TIMEOUT          200
+
+/**
+ * @brief   Returned instead of a status when no valid response came.
+ */
+#define CUBE_RPC_NO_RESPONSE      -1
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  int cubeOpen(const char *path);
+  void cubeClose(int fd);
+  uint8_t cubeCrc(const uint8_t *p, size_t n);
+  int cubeCall(int fd, uint8_t cmd, const uint8_t *data, uint8_t *result);
+  int cubeSetText(int fd, const char *text, size_t n);
+  int cubeUploadShow(int fd, const uint8_t *buf, size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CUBERPC_H_ */
@@ -0,0 +1,403 @@
+/**
+ *
+ * @file    deadlinetest.c
+ *
+ * @brief   Host tests of the deadline monitoring, with injected overruns.
+ *
+ * @details Builds anim.c and monitor.c on the host. The animations, the
+ *          refresh statistics and the watchdog are emulated: a step takes
+ *          the time set by the test, a suspended thread lets the time run
+ *          to its timeout and the check timer of the monitor fires on
+ *          time. The tests check:
+ *          - steps ending before or exactly at their deadline are not
+ *            missed, the steps keep their absolute schedule,
+ *          - overrunning steps are all missed and the worst overrun is
+ *            the one injected, a single overrun is missed once and the
+ *            following steps are on time again,
+ *          - the watchdog is fed while the refresh misses at most
+ *            @p MONITOR_REFRESH_MISSES scans per check and starved with
+ *            one more, or when the refresh stops,
+ *          - the watchdog is fed during the longest legitimate step and
+ *            starved when a step hangs,
+ *          - the driver demo is supervised as @p MONITOR_DEMO_CHECKS says.
+ *          .
+ *
+ *          Usage: deadlinetest
+ *          The exit status is 1 when a test failed.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdio.h>
+
+/* Host files. */
+#include <avr/wdt.h>
+
+/* Firmware files. */
+#include "ledcube.h"
+#include "display.h"
+#include "effects.h"
+#include "scroll.h"
+#include "show.h"
+#include "tween.h"
+#include "telemetry.h"
+#include "input.h"
+#include "sync.h"
+#include "anim.h"
+#include "monitor.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Ticks of a number of seconds, longer than the system time.
+ */
+#define SECONDS(s)                ((uint32_t)(s) * CH_CFG_ST_FREQUENCY)
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   System time of the firmware modules, see host/ch.h
+ */
+systime_t host_time;
+
+/**
+ * @brief   Emulation state.
+ */
+static struct {
+  /* Time since the start, the system time wraps.*/
+  uint32_t        now;
+  /* Duration and period of the steps, duration of the next step when not
+     zero, duration of the driver demo.*/
+  systime_t       cost;
+  systime_t       period;
+  uint32_t        spike;
+  uint32_t        demo;
+  /* Refresh: running, statistics and late scans per check.*/
+  bool            active;
+  bool            stalled;
+  display_stats_t refresh;
+  uint16_t        misses;
+  /* Check timer of the monitor.*/
+  virtual_timer_t *timer;
+  uint32_t        due;
+  /* Watchdog: timeout, time since the last feed and time it bit at.*/
+  uint32_t        wdt;
+  uint32_t        unfed;
+  bool            bitten;
+  uint32_t        bite;
+} sim;
+
+static int failures;
+
+/*==========================================================================*/
+/* Emulation.                                                               */
+/*==========================================================================*/
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    if (!(cond)) {                                                           \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);        \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+/**
+ * @brief   Lets the time run, the check timer fires on time and the
+ *          watchdog bites when it is not fed in time.
+ */
+static void advance(uint32_t ticks) {
+  virtual_timer_t *vtp;
+  uint32_t d;
+
+  while (ticks > 0) {
+    d = ticks;
+    if ((sim.timer != NULL) && ((sim.due - sim.now) < d))
+      d = sim.due - sim.now;
+    sim.now += d;
+    host_time = (systime_t)sim.now;
+    ticks -= d;
+
+    sim.unfed += d;
+    if ((sim.unfed > sim.wdt) && !sim.bitten) {
+      sim.bitten = true;
+      sim.bite = sim.now;
+    }
+
+    if ((sim.timer != NULL) && (sim.now == sim.due)) {
+      if (sim.active && !sim.stalled) {
+        sim.refresh.scans++;
+        sim.refresh.missed += sim.misses;
+      }
+      vtp = sim.timer;
+      sim.timer = NULL;
+      vtp->func(vtp->par);
+    }
+  }
+}
+
+msg_t chThdSuspendTimeoutS(thread_reference_t *trp, systime_t timeout) {
+
+  (void)trp;
+  advance(timeout);
+
+  return MSG_TIMEOUT;
+}
+
+void chVTSetI(virtual_timer_t *vtp, systime_t delay, vtfunc_t vtfunc,
+              void *par) {
+
+  vtp->func = vtfunc;
+  vtp->par  = par;
+  sim.timer = vtp;
+  sim.due   = sim.now + delay;
+}
+
+void wdt_enable(uint8_t timeout) {
+
+  sim.wdt = MS2ST(16UL << timeout);
+  sim.unfed = 0;
+}
+
+void wdt_reset(void) {
+
+  sim.unfed = 0;
+}
+
+void displayStart(void) {
+
+  sim.active = true;
+}
+
+void displayStop(void) {
+
+  sim.active = false;
+}
+
+bool displayIsActive(void) {
+
+  return sim.active;
+}
+
+void displayGetStatsI(display_stats_t *sp) {
+
+  *sp = sim.refresh;
+}
+
+static systime_t effects_step(void) {
+
+  if (sim.spike > 0) {
+    advance(sim.spike);
+    sim.spike = 0;
+  }
+  else {
+    advance(sim.cost);
+  }
+
+  return sim.period;
+}
+
+void effectsStart(uint8_t stream) {
+
+  (void)stream;
+}
+
+systime_t effectsSparkleStep(void) {
+
+  return effects_step();
+}
+
+systime_t effectsRainStep(void) {
+
+  return effects_step();
+}
+
+systime_t effectsFillStep(void) {
+
+  return effects_step();
+}
+
+void ledCubeDemo(void) {
+
+  advance(sim.demo);
+}
+
+/* Animations and modules left out of the tests.*/
+void scrollStep(void) {}
+void showStart(void) {}
+systime_t showStep(void) { return sim.period; }
+bool showSeek(uint32_t ticks) { (void)ticks; return false; }
+void tweenStart(void) {}
+systime_t tweenStep(void) { return sim.period; }
+bool tweenSeek(uint32_t ticks) { (void)ticks; return false; }
+uint8_t inputProcess(void) { return 0; }
+uint8_t syncGetRole(void) { return SYNC_NONE; }
+void syncSendTick(uint8_t id, uint16_t step) { (void)id; (void)step; }
+void telemetryStep(void) {}
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Plays an animation for a time, with steps of a duration and a
+ *          period.
+ *
+ * @return  the steps played and missed during that time.
+ */
+static anim_stats_t run(uint8_t id, uint32_t ticks, systime_t cost,
+                        systime_t period) {
+  anim_stats_t before, after;
+  uint32_t end = sim.now + ticks;
+
+  sim.cost   = cost;
+  sim.period = period;
+  sim.unfed  = 0;
+  sim.bitten = false;
+  if (animGetSelected() != id)
+    animSelect(id);
+
+  animGetStatsI(&before);
+  while ((int32_t)(end - sim.now) > 0)
+    animRun();
+  animGetStatsI(&after);
+
+  after.steps  -= before.steps;
+  after.missed -= before.missed;
+
+  return after;
+}
+
+static void test_on_time(void) {
+  anim_stats_t st;
+
+  /* Long enough for the system time to wrap.*/
+  st = run(ANIM_SPARKLE, SECONDS(10), MS2ST(5), MS2ST(20));
+  CHECK(st.missed == 0);
+  CHECK(st.worst == 0);
+  CHECK((st.steps >= 499) && (st.steps <= 501));
+  CHECK(!sim.bitten);
+  printf("on time: %u steps, %u missed\n", st.steps, st.missed);
+
+  st = run(ANIM_SPARKLE, SECONDS(10), MS2ST(20), MS2ST(20));
+  CHECK(st.missed == 0);
+  CHECK(st.worst == 0);
+  CHECK((st.steps >= 499) && (st.steps <= 501));
+  CHECK(!sim.bitten);
+  printf("steps as long as their period: %u steps, %u missed\n", st.steps,
+         st.missed);
+}
+
+static void test_overruns(void) {
+  anim_stats_t st;
+
+  st = run(ANIM_SPARKLE, SECONDS(5), MS2ST(23), MS2ST(20));
+  CHECK(st.missed >= (st.steps - 1));
+  CHECK(st.worst == (MS2ST(23) - MS2ST(20)));
+  CHECK(!sim.bitten);
+  printf("overrun of every step: %u steps, %u missed, worst %u ticks\n",
+         st.steps, st.missed, st.worst);
+
+  sim.spike = MS2ST(100);
+  st = run(ANIM_SPARKLE, SECONDS(5), MS2ST(5), MS2ST(20));
+  CHECK(st.missed == 1);
+  CHECK(st.worst == (MS2ST(100) - MS2ST(20)));
+  CHECK((st.steps >= 245) && (st.steps <= 247));
+  CHECK(!sim.bitten);
+  printf("one overrun: %u steps, %u missed, worst %u ticks\n", st.steps,
+         st.missed, st.worst);
+}
+
+static void test_refresh(void) {
+
+  sim.misses = MONITOR_REFRESH_MISSES;
+  (void)run(ANIM_SPARKLE, SECONDS(5), MS2ST(5), MS2ST(20));
+  CHECK(!sim.bitten);
+
+  sim.misses = MONITOR_REFRESH_MISSES + 1;
+  (void)run(ANIM_SPARKLE, SECONDS(5), MS2ST(5), MS2ST(20));
+  CHECK(sim.bitten);
+  sim.misses = 0;
+  printf("refresh missing %u scans per check: watchdog fed, %u: reset\n",
+         MONITOR_REFRESH_MISSES, MONITOR_REFRESH_MISSES + 1);
+
+  sim.stalled = true;
+  (void)run(ANIM_SPARKLE, SECONDS(5), MS2ST(5), MS2ST(20));
+  CHECK(sim.bitten);
+  sim.stalled = false;
+  printf("refresh stopped: reset\n");
+}
+
+static void test_hung_step(void) {
+  uint32_t start;
+
+  /* A stored animation frame lasts 2 s at most.*/
+  (void)run(ANIM_SPARKLE, SECONDS(10), MS2ST(5), S2ST(2));
+  CHECK(!sim.bitten);
+
+  sim.spike = SECONDS(3);
+  (void)run(ANIM_SPARKLE, SECONDS(5), MS2ST(5), MS2ST(20));
+  CHECK(!sim.bitten);
+
+  /* A step stuck for longer than the checks allow.*/
+  sim.spike = (uint32_t)(MONITOR_ANIM_CHECKS + 2) * MONITOR_PERIOD +
+              SECONDS(1);
+  start = sim.now;
+  (void)run(ANIM_SPARKLE, SECONDS(1), MS2ST(5), MS2ST(20));
+  CHECK(sim.bitten);
+  printf("steps of 2 s and a step of 3 s: watchdog fed, hung step: reset "
+         "%lu ms after its start\n",
+         (unsigned long)(sim.bite - start) * 1000 / CH_CFG_ST_FREQUENCY);
+}
+
+static void test_demo(void) {
+
+  /* Demo runs of 30 s.*/
+  sim.demo = SECONDS(30);
+  (void)run(ANIM_DEMO, SECONDS(60), 0, 0);
+#if MONITOR_DEMO_CHECKS == 0
+  CHECK(!sim.bitten);
+  printf("demo: not supervised, MONITOR_DEMO_CHECKS is 0\n");
+#else
+  CHECK(sim.bitten ==
+        (SECONDS(30) > ((uint32_t)MONITOR_DEMO_CHECKS * MONITOR_PERIOD)));
+  printf("demo: supervised for %u checks\n", MONITOR_DEMO_CHECKS);
+#endif
+}
+
+/*
+ * Tool entry point.
+ */
+int main(void) {
+
+  animInit();
+  animSelect(ANIM_SPARKLE);
+  sim.period = MS2ST(20);
+  animRun();
+  monitorStart();
+
+  test_on_time();
+  test_overruns();
+  test_refresh();
+  test_hung_step();
+  test_demo();
+
+  if (failures > 0) {
+    printf("%d checks failed\n", failures);
+    return 1;
+  }
+  printf("all deadline tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ *
+ * @file    eeprom.h
+ *
+ * @brief   Host stand-in of the avr-libc EEPROM header for the host tests.
+ *
+ * @details The EEPROM of the ATmega328p is emulated in RAM, see eeprom.c,
+ *          it is loaded from and saved to a file to emulate the resets. A
+ *          power loss can be injected after a number of byte writes.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _AVR_EEPROM_H_
+#define _AVR_EEPROM_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <setjmp.h>
+#include <stdint.h>
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Last EEPROM address of the ATmega328p.
+ */
+#define E2END                     0x3FF
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+/**
+ * @brief   Jumped to by the write which hits the injected power loss.
+ */
+extern jmp_buf eeprom_power_loss;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint8_t eeprom_read_byte(const uint8_t *p);
+  void eeprom_update_byte(uint8_t *p, uint8_t value);
+  int eepromLoad(const char *path);
+  int eepromSave(const char *path);
+  void eepromErase(void);
+  void eepromCutAfter(long writes);
+  unsigned long eepromGetWrites(uint16_t addr);
+  unsigned long eepromGetReads(void);
+  void eepromResetCounters(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVR_EEPROM_H_ */
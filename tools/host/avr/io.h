@@ -0,0 +1,31 @@
+/**
+ *
+ * @file    io.h
+ *
+ * @brief   Host stand-in of the avr-libc register header for the host
+ *          tests.
+ *
+ * @details The registers used by the firmware modules built on the host
+ *          are plain variables, defined by the test using them.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _AVR_IO_H_
+#define _AVR_IO_H_
+
+#include <stdint.h>
+
+/**
+ * @brief   Timer 2 prescaler bit of TCCR2B.
+ */
+#define CS21                      1
+
+extern volatile uint8_t PORTB, PORTC, PORTD;
+extern volatile uint8_t DDRB, DDRC, DDRD;
+extern volatile uint8_t TCCR2A, TCCR2B, TCNT2;
+
+#endif /* _AVR_IO_H_ */
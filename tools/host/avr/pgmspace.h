@@ -0,0 +1,28 @@
+/**
+ *
+ * @file    pgmspace.h
+ *
+ * @brief   Host stand-in of the avr-libc program space header for the host
+ *          tests.
+ *
+ * @details The host has one address space, the data kept in flash is read
+ *          like any other.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _AVR_PGMSPACE_H_
+#define _AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+
+#define pgm_read_byte(p)          (*(const uint8_t *)(p))
+#define pgm_read_word(p)          (*(const uint16_t *)(p))
+#define pgm_read_ptr(p)           (*(void * const *)(p))
+
+#endif /* _AVR_PGMSPACE_H_ */
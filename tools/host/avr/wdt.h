@@ -0,0 +1,36 @@
+/**
+ *
+ * @file    wdt.h
+ *
+ * @brief   Host stand-in of the avr-libc watchdog header for the host
+ *          tests.
+ *
+ * @details The watchdog is emulated by the test.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _AVR_WDT_H_
+#define _AVR_WDT_H_
+
+#include <stdint.h>
+
+/**
+ * @brief   Watchdog timeouts, about 16 ms times two to their power.
+ */
+#define WDTO_15MS                 0
+#define WDTO_30MS                 1
+#define WDTO_60MS                 2
+#define WDTO_120MS                3
+#define WDTO_250MS                4
+#define WDTO_500MS                5
+#define WDTO_1S                   6
+#define WDTO_2S                   7
+
+void wdt_enable(uint8_t timeout);
+void wdt_reset(void);
+
+#endif /* _AVR_WDT_H_ */
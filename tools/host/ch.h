@@ -0,0 +1,120 @@
+/**
+ *
+ * @file    ch.h
+ *
+ * @brief   Host stand-in of the ChibiOS kernel header for the host tests.
+ *
+ * @details The firmware modules built on the host run in one thread: the
+ *          locks do nothing and the system time is a variable set by the
+ *          test, @p host_time. A thread suspending itself and the virtual
+ *          timers are emulated by the test too, with
+ *          @p chThdSuspendTimeoutS() and @p chVTSetI().
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _CH_H_
+#define _CH_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   System tick frequency of the firmware, see chconf.h
+ */
+#define CH_CFG_ST_FREQUENCY       15624
+
+/**
+ * @brief   Shortest delay of the tickless timer, see chconf.h
+ */
+#define CH_CFG_ST_TIMEDELTA       2
+
+#define TRUE                      1
+#define FALSE                     0
+
+#define NORMALPRIO                128
+
+#define MSG_OK                    0
+#define MSG_TIMEOUT               -1
+#define MSG_RESET                 -2
+
+#define TIME_IMMEDIATE            ((systime_t)0)
+#define TIME_INFINITE             ((systime_t)-1)
+
+/*==========================================================================*/
+/* Types.                                                                   */
+/*==========================================================================*/
+
+typedef uint16_t systime_t;
+typedef uint8_t tprio_t;
+typedef int16_t msg_t;
+typedef void *thread_reference_t;
+
+typedef struct {
+  int owner;
+} mutex_t;
+
+typedef void (*vtfunc_t)(void *p);
+
+typedef struct {
+  vtfunc_t  func;
+  void      *par;
+} virtual_timer_t;
+
+/*==========================================================================*/
+/* Macros.                                                                  */
+/*==========================================================================*/
+
+#define S2ST(sec)                                                            \
+  ((systime_t)((uint32_t)(sec) * (uint32_t)CH_CFG_ST_FREQUENCY))
+
+#define MS2ST(msec)                                                          \
+  ((systime_t)(((((uint32_t)(msec)) * ((uint32_t)CH_CFG_ST_FREQUENCY)) +    \
+                999UL) / 1000UL))
+
+#define US2ST(usec)                                                          \
+  ((systime_t)(((((uint32_t)(usec)) * ((uint32_t)CH_CFG_ST_FREQUENCY)) +    \
+                999999UL) / 1000000UL))
+
+#define chSysLock()
+#define chSysUnlock()
+#define chSysLockFromISR()
+#define chSysUnlockFromISR()
+
+#define chMtxObjectInit(mp)       ((void)(mp))
+#define chMtxLock(mp)             ((void)(mp))
+#define chMtxUnlock(mp)           ((void)(mp))
+
+#define chVTGetSystemTimeX()      (host_time)
+#define chVTGetSystemTime()       (host_time)
+
+#define chThdResumeI(trp, msg)    ((void)(trp), (void)(msg))
+#define chSchRescheduleS()
+
+#define chVTObjectInit(vtp)       ((vtp)->func = NULL)
+#define chVTResetI(vtp)           ((vtp)->func = NULL)
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+extern systime_t host_time;
+
+msg_t chThdSuspendTimeoutS(thread_reference_t *trp, systime_t timeout);
+void chVTSetI(virtual_timer_t *vtp, systime_t delay, vtfunc_t vtfunc,
+              void *par);
+
+#endif /* _CH_H_ */
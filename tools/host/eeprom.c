@@ -0,0 +1,184 @@
+/**
+ *
+ * @file    eeprom.c
+ *
+ * @brief   File-backed EEPROM emulation for the host tests.
+ *
+ * @details The cells start erased, at 0xFF. eepromLoad() and eepromSave()
+ *          read and write the whole EEPROM as a 1 KB file, a test emulates
+ *          a reset by saving the EEPROM and loading it back before calling
+ *          the initialization of the module again.
+ *          eepromCutAfter() injects a power loss: the write following the
+ *          allowed ones does not happen and jumps to
+ *          @p eeprom_power_loss instead. The writes of each cell and the
+ *          reads are counted, for the endurance and the boot time.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdio.h>
+#include <string.h>
+
+/* Local files. */
+#include "avr/eeprom.h"
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   EEPROM state.
+ */
+static struct {
+  uint8_t       cells[E2END + 1];
+  /* Writes of each cell and reads since the last reset of the counters.*/
+  unsigned long writes[E2END + 1];
+  unsigned long reads;
+  /* Writes allowed before the power loss, negative when none is set.*/
+  long          left;
+  int           erased;
+} eeprom = {.left = -1};
+
+/**
+ * @brief   Jumped to by the write which hits the injected power loss.
+ */
+jmp_buf eeprom_power_loss;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+static void eeprom_init(void) {
+
+  if (!eeprom.erased) {
+    memset(eeprom.cells, 0xFF, sizeof(eeprom.cells));
+    eeprom.erased = 1;
+  }
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Reads a cell, as avr-libc.
+ */
+uint8_t eeprom_read_byte(const uint8_t *p) {
+  uintptr_t addr = (uintptr_t)p;
+
+  eeprom_init();
+  if (addr > E2END)
+    return 0xFF;
+  eeprom.reads++;
+
+  return eeprom.cells[addr];
+}
+
+/**
+ * @brief   Writes a cell if its value changes, as avr-libc.
+ */
+void eeprom_update_byte(uint8_t *p, uint8_t value) {
+  uintptr_t addr = (uintptr_t)p;
+
+  eeprom_init();
+  if ((addr > E2END) || (eeprom.cells[addr] == value))
+    return;
+
+  if (eeprom.left == 0) {
+    eeprom.left = -1;
+    longjmp(eeprom_power_loss, 1);
+  }
+  if (eeprom.left > 0)
+    eeprom.left--;
+
+  eeprom.cells[addr] = value;
+  eeprom.writes[addr]++;
+}
+
+/**
+ * @brief   Loads the EEPROM from a file.
+ *
+ * @return  0 on success, -1 on error.
+ */
+int eepromLoad(const char *path) {
+  FILE *f = fopen(path, "rb");
+  size_t n;
+
+  if (f == NULL)
+    return -1;
+  n = fread(eeprom.cells, 1, sizeof(eeprom.cells), f);
+  fclose(f);
+  eeprom.erased = 1;
+
+  return (n == sizeof(eeprom.cells)) ? 0 : -1;
+}
+
+/**
+ * @brief   Saves the EEPROM to a file.
+ *
+ * @return  0 on success, -1 on error.
+ */
+int eepromSave(const char *path) {
+  FILE *f = fopen(path, "wb");
+  size_t n;
+
+  if (f == NULL)
+    return -1;
+  eeprom_init();
+  n = fwrite(eeprom.cells, 1, sizeof(eeprom.cells), f);
+
+  return ((fclose(f) == 0) && (n == sizeof(eeprom.cells))) ? 0 : -1;
+}
+
+/**
+ * @brief   Erases all the cells, as a new chip.
+ */
+void eepromErase(void) {
+
+  memset(eeprom.cells, 0xFF, sizeof(eeprom.cells));
+  eeprom.erased = 1;
+}
+
+/**
+ * @brief   Injects a power loss after a number of writes.
+ *
+ * @param[in] writes    writes allowed, negative cancels the power loss
+ */
+void eepromCutAfter(long writes) {
+
+  eeprom.left = writes;
+}
+
+/**
+ * @brief   Returns the writes of a cell since the last reset of the
+ *          counters.
+ */
+unsigned long eepromGetWrites(uint16_t addr) {
+
+  return (addr <= E2END) ? eeprom.writes[addr] : 0;
+}
+
+/**
+ * @brief   Returns the reads since the last reset of the counters.
+ */
+unsigned long eepromGetReads(void) {
+
+  return eeprom.reads;
+}
+
+/**
+ * @brief   Resets the counters of writes and reads.
+ */
+void eepromResetCounters(void) {
+
+  memset(eeprom.writes, 0, sizeof(eeprom.writes));
+  eeprom.reads = 0;
+}
@@ -0,0 +1,25 @@
+/**
+ *
+ * @file    hal.h
+ *
+ * @brief   Host stand-in of the ChibiOS HAL header for the host tests.
+ *
+ * @details The firmware modules built on the host need the kernel types, the
+ *          channel type and the registers of host/avr/io.h.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _HAL_H_
+#define _HAL_H_
+
+#include <avr/io.h>
+
+#include "ch.h"
+
+typedef struct BaseChannel BaseChannel;
+
+#endif /* _HAL_H_ */
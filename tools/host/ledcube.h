@@ -0,0 +1,20 @@
+/**
+ *
+ * @file    ledcube.h
+ *
+ * @brief   Host stand-in of the ledcube driver header for the host tests.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _LEDCUBE_H_
+#define _LEDCUBE_H_
+
+#include "ch.h"
+
+void ledCubeDemo(void);
+
+#endif /* _LEDCUBE_H_ */
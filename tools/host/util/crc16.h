@@ -0,0 +1,31 @@
+/**
+ *
+ * @file    crc16.h
+ *
+ * @brief   Host stand-in of the avr-libc CRC header for the host tests.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _UTIL_CRC16_H_
+#define _UTIL_CRC16_H_
+
+#include <stdint.h>
+
+/**
+ * @brief   CRC8 update, polynomial 0x07, as the avr-libc one.
+ */
+static inline uint8_t _crc8_ccitt_update(uint8_t crc, uint8_t data) {
+  uint8_t i;
+
+  crc ^= data;
+  for (i = 0; i < 8; i++)
+    crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+
+  return crc;
+}
+
+#endif /* _UTIL_CRC16_H_ */
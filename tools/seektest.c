@@ -0,0 +1,319 @@
+/**
+ *
+ * @file    seektest.c
+ *
+ * @brief   Host tests of the timecode seeks of the animations.
+ *
+ * @details Builds show.c and tween.c on the host, with store.c on the
+ *          emulated EEPROM of host/eeprom.c and stand-ins of the display
+ *          keeping the last committed frame. Each animation is first played
+ *          step by step, its loop is the shortest sequence of frames played
+ *          again and again. Then, from every position reached by sequential
+ *          steps, it is moved to every frame of the loop at a time one or
+ *          two loops later. The tests check:
+ *          - the step after a seek commits the frame sequential playback
+ *            shows at that time, and the following steps go on as
+ *            sequential playback,
+ *          - a seek less than one frame away does nothing and says so, the
+ *            animation thread then keeps its pace, see animSeek(),
+ *          - the stored animation replays at most SHOW_INDEX_INTERVAL - 1
+ *            frames per seek whatever the time.
+ *          .
+ *
+ *          Usage: seektest
+ *          The exit status is 1 when a test failed.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Host files. */
+#include <avr/eeprom.h>
+
+/* Firmware files. */
+#include "display.h"
+#include "store.h"
+#include "config.h"
+#include "show.h"
+#include "tween.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Frames of the stored animation of the test and their period, in
+ *          units of 10 ms.
+ */
+#define SHOW_FRAMES               40
+#define SHOW_PERIOD               3
+
+/**
+ * @brief   Steps checked after each seek.
+ */
+#define FOLLOW_STEPS              (SHOW_INDEX_INTERVAL + 2)
+
+/**
+ * @brief   Most frames of a loop of the animations of the test.
+ */
+#define MAX_FRAMES                256
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Frame committed to the display, the grayscale planes or the
+ *          frame in the first plane.
+ */
+typedef struct {
+  display_gray_t  gray;
+} frame_t;
+
+/**
+ * @brief   Animation under test.
+ */
+typedef struct {
+  const char  *name;
+  void        (*start)(void);
+  systime_t   (*step)(void);
+  bool        (*seek)(uint32_t ticks);
+  /* Frames of a loop and frame period.*/
+  uint16_t    frames;
+  systime_t   period;
+} anim_test_t;
+
+/**
+ * @brief   System time of the firmware modules, see host/ch.h
+ */
+systime_t host_time;
+
+static frame_t committed;
+static frame_t reference[2 * MAX_FRAMES];
+static int failures;
+
+/*==========================================================================*/
+/* Stand-ins of the display driver.                                         */
+/*==========================================================================*/
+
+void displayCommit(const display_frame_t *fp) {
+
+  memset(&committed, 0, sizeof(committed));
+  committed.gray.plane[0] = *fp;
+}
+
+void displayCommitGray(const display_gray_t *gp) {
+
+  committed.gray = *gp;
+}
+
+/* Only the listed voxels are taken, like the driver does.*/
+void displayCommitVoxels(const display_gray_t *gp, const uint8_t *voxels,
+                         uint8_t n) {
+  uint8_t i, c, bit, b;
+
+  for (i = 0; i < n; i++) {
+    c   = voxels[i] / DISPLAY_LAYERS;
+    bit = 1U << (voxels[i] % DISPLAY_LAYERS);
+    for (b = 0; b < DISPLAY_GRAY_BITS; b++) {
+      committed.gray.plane[b].col[c] &= ~bit;
+      committed.gray.plane[b].col[c] |= gp->plane[b].col[c] & bit;
+    }
+  }
+}
+
+void displayClear(display_frame_t *fp) {
+
+  memset(fp, 0, sizeof(*fp));
+}
+
+void displaySetLevel(display_gray_t *gp, uint8_t c, uint8_t z,
+                     uint8_t level) {
+  uint8_t bit = 1U << z;
+  uint8_t b;
+
+  for (b = 0; b < DISPLAY_GRAY_BITS; b++) {
+    if (level & 1)
+      gp->plane[b].col[c] |= bit;
+    else
+      gp->plane[b].col[c] &= ~bit;
+    level >>= 1;
+  }
+}
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    if (!(cond)) {                                                           \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);        \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+/**
+ * @brief   Tells if the committed frame is a frame of the reference loop.
+ */
+static int shows(uint16_t frame) {
+
+  return memcmp(&committed, &reference[frame], sizeof(committed)) == 0;
+}
+
+/**
+ * @brief   Tells if two frames of the reference are the same.
+ */
+static int shows_at(uint16_t a, uint16_t b) {
+
+  return memcmp(&reference[a], &reference[b], sizeof(frame_t)) == 0;
+}
+
+/**
+ * @brief   Stores an animation of random frames, each one changing up to
+ *          three columns.
+ *
+ * @return  the number of frames stored.
+ */
+static uint16_t store_show(void) {
+  uint8_t buf[STORE_MAX_PAYLOAD];
+  uint16_t frames, mask;
+  uint8_t c, n = 1;
+
+  buf[0] = SHOW_PERIOD;
+  srand(1);
+  for (frames = 0; frames < SHOW_FRAMES; frames++) {
+    mask = 0;
+    for (c = rand() % 4; c > 0; c--)
+      mask |= 1U << (rand() % DISPLAY_COLUMNS);
+    if ((n + 2 + DISPLAY_COLUMNS) > STORE_MAX_PAYLOAD)
+      break;
+    buf[n++] = (uint8_t)mask;
+    buf[n++] = (uint8_t)(mask >> 8);
+    for (c = 0; c < DISPLAY_COLUMNS; c++) {
+      if (mask & (1U << c))
+        buf[n++] = (uint8_t)rand() & 0x07;
+    }
+  }
+
+  CHECK(storeWrite(CONFIG_KEY_SHOW, buf, n));
+
+  return frames;
+}
+
+/**
+ * @brief   Plays an animation step by step and finds its loop.
+ *
+ * @return  the frames of the loop, the shortest sequence played again and
+ *          again.
+ */
+static uint16_t play_reference(const anim_test_t *tp) {
+  uint16_t k, n;
+
+  tp->start();
+  for (k = 0; k < (2 * MAX_FRAMES); k++) {
+    CHECK(tp->step() == tp->period);
+    reference[k] = committed;
+  }
+
+  for (n = 1; n < MAX_FRAMES; n++) {
+    for (k = 0; (k < MAX_FRAMES) && shows_at(k, k + n); k++)
+      ;
+    if (k == MAX_FRAMES)
+      break;
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Seeks an animation from every position to every frame.
+ */
+static void test_seeks(const anim_test_t *tp) {
+  unsigned long seeks = 0, moved = 0, reads, worst = 0;
+  uint16_t p, f, from, next, shown, k;
+  uint32_t t;
+  bool done;
+
+  CHECK(play_reference(tp) == tp->frames);
+
+  for (p = 0; p <= tp->frames; p++) {
+    for (f = 0; f < tp->frames; f++) {
+      tp->start();
+      for (k = 0; k < p; k++)
+        (void)tp->step();
+
+      /* Middle of the frame, one or two loops after the start.*/
+      t = (uint32_t)(f + (1 + (p & 1)) * tp->frames) * tp->period +
+          tp->period / 2;
+      eepromResetCounters();
+      done = tp->seek(t);
+      reads = eepromGetReads();
+      if (reads > worst)
+        worst = reads;
+
+      next  = p % tp->frames;
+      shown = (p > 0) ? (p - 1) % tp->frames : tp->frames - 1;
+      seeks++;
+      if (done) {
+        moved++;
+        CHECK((f != next) && (f != shown));
+        from = f;
+      }
+      else {
+        /* Less than one frame away, the sequence goes on.*/
+        CHECK((f == next) || (f == shown));
+        from = next;
+      }
+
+      for (k = 0; k < FOLLOW_STEPS; k++) {
+        (void)tp->step();
+        CHECK(shows((from + k) % tp->frames));
+      }
+    }
+  }
+
+  printf("%s: %u frames, %lu seeks, %lu moved, worst seek %lu EEPROM "
+         "reads\n", tp->name, tp->frames, seeks, moved, worst);
+  CHECK(moved == (seeks - 2 * (tp->frames + 1)));
+  if (tp->seek == showSeek)
+    CHECK(worst <= (SHOW_INDEX_INTERVAL - 1) * (2 + DISPLAY_COLUMNS));
+}
+
+/*
+ * Tool entry point.
+ */
+int main(void) {
+  anim_test_t show = {"show", showStart, showStep, showSeek, 0,
+                      MS2ST(10 * SHOW_PERIOD)};
+  anim_test_t tween = {"tween", tweenStart, tweenStep, tweenSeek, 0,
+                       TWEEN_FRAME_PERIOD};
+
+  eepromErase();
+  storeInit();
+  show.frames = store_show();
+  test_seeks(&show);
+
+  /* The keyframes are not known here, the loop is the one played.*/
+  tween.frames = play_reference(&tween);
+  test_seeks(&tween);
+
+  if (failures > 0) {
+    printf("%d checks failed\n", failures);
+    return 1;
+  }
+  printf("all seek tests passed\n");
+
+  return 0;
+}
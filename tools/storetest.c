@@ -0,0 +1,417 @@
+/**
+ *
+ * @file    storetest.c
+ *
+ * @brief   Host tests of the persistent store.
+ *
+ * @details Builds store.c on the host on the file-backed EEPROM of
+ *          host/eeprom.c, a reset saves the EEPROM to the file and loads it
+ *          back before storeInit(). The tests check:
+ *          - the startup: the records are found after a reset, by one scan
+ *            of the active bank,
+ *          - the torn writes: a power loss at any byte write of a record
+ *            leaves the previous payload of its key, the other keys are
+ *            intact,
+ *          - the compaction: same with a power loss at any byte write of
+ *            the compaction of the bank,
+ *          - the generation wrap-around: the newest bank is still the
+ *            active one once its generation wrapped past 255,
+ *          - the records by parts: an open upload is kept while the
+ *            settings wait, an abandoned one is dropped,
+ *          - the endurance: the writes of the worst cell per bank fill.
+ *          .
+ *
+ *          Usage: storetest [file]
+ *          - file: EEPROM file, storetest.eep by default.
+ *          .
+ *          The exit status is 1 when a test failed.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdio.h>
+#include <string.h>
+
+/* Host files. */
+#include <avr/eeprom.h>
+
+/* Firmware files. */
+#include "store.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Keys used by the tests.
+ */
+#define KEY_A                     1
+#define KEY_B                     2
+#define KEY_C                     3
+
+/**
+ * @brief   Payload size of the records written over and over.
+ */
+#define PAYLOAD                   8
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   System time of the firmware modules, see host/ch.h
+ */
+systime_t host_time;
+
+static const char *eep = "storetest.eep";
+static const char *snapshot = "storetest.snap";
+static int failures;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    if (!(cond)) {                                                           \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);        \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+/**
+ * @brief   Emulates a reset: saves the EEPROM, loads it back and finds the
+ *          records again.
+ */
+static void reset(void) {
+
+  eepromCutAfter(-1);
+  CHECK(eepromSave(eep) == 0);
+  CHECK(eepromLoad(eep) == 0);
+  storeInit();
+}
+
+/**
+ * @brief   Fills a payload from a value.
+ */
+static void fill(uint8_t *p, uint8_t value) {
+  uint8_t i;
+
+  for (i = 0; i < PAYLOAD; i++)
+    p[i] = (uint8_t)(value + i);
+}
+
+/**
+ * @brief   Tells if a key holds the payload of a value.
+ */
+static int holds(uint8_t key, uint8_t value) {
+  uint8_t want[PAYLOAD], got[PAYLOAD];
+
+  fill(want, value);
+  return (storeRead(key, 0, got, PAYLOAD) == PAYLOAD) &&
+         (memcmp(want, got, PAYLOAD) == 0);
+}
+
+/**
+ * @brief   Writes the payload of a value.
+ */
+static int put(uint8_t key, uint8_t value) {
+  uint8_t p[PAYLOAD];
+
+  fill(p, value);
+  return storeWrite(key, p, PAYLOAD);
+}
+
+/**
+ * @brief   Returns the byte writes done since the last reset of the
+ *          counters.
+ */
+static unsigned long writes(void) {
+  unsigned long n = 0;
+  uint16_t addr;
+
+  for (addr = 0; addr <= E2END; addr++)
+    n += eepromGetWrites(addr);
+
+  return n;
+}
+
+/**
+ * @brief   Writes the payload of a value to @p KEY_A with a power loss
+ *          after some byte writes.
+ *
+ * @return  true if the power was lost before the end of the write.
+ */
+static int cut_put(long k, uint8_t value) {
+
+  eepromCutAfter(k);
+  if (setjmp(eeprom_power_loss) != 0)
+    return 1;
+  (void)put(KEY_A, value);
+
+  return 0;
+}
+
+/**
+ * @brief   Cuts the power at each byte write of the write of @p value to
+ *          @p KEY_A, from the EEPROM of the snapshot, and checks the keys
+ *          after the reset.
+ *
+ * @param[in] old   value of @p KEY_A in the snapshot
+ * @param[in] value value written
+ * @return          the byte writes of the complete write.
+ */
+static unsigned long torn(uint8_t old, uint8_t value) {
+  unsigned long n, k;
+
+  /* Complete write first, counts its byte writes.*/
+  CHECK(eepromLoad(snapshot) == 0);
+  storeInit();
+  eepromResetCounters();
+  CHECK(put(KEY_A, value));
+  n = writes();
+
+  for (k = 0; k < n; k++) {
+    CHECK(eepromLoad(snapshot) == 0);
+    storeInit();
+    CHECK(cut_put((long)k, value));
+    reset();
+
+    /* The key byte is written last, the write never happened.*/
+    CHECK(holds(KEY_A, old));
+    CHECK(holds(KEY_B, 0x42));
+    CHECK(holds(KEY_C, 0x17));
+
+    /* The log goes on after the torn record.*/
+    CHECK(put(KEY_A, value));
+    reset();
+    CHECK(holds(KEY_A, value));
+    CHECK(holds(KEY_B, 0x42));
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Starts from an erased EEPROM with three keys.
+ */
+static void format(void) {
+
+  eepromCutAfter(-1);
+  eepromErase();
+  storeInit();
+  CHECK(put(KEY_A, 0x01));
+  CHECK(put(KEY_B, 0x42));
+  CHECK(put(KEY_C, 0x17));
+}
+
+/**
+ * @brief   Writes @p KEY_A until the next write compacts the bank.
+ *
+ * @param[in,out] value     last value written, incremented by each write
+ */
+static void fill_bank(uint8_t *value) {
+  uint8_t gen = storeGetGeneration();
+
+  while (1) {
+    CHECK(eepromSave(snapshot) == 0);
+    CHECK(put(KEY_A, (uint8_t)(*value + 1)));
+    if (storeGetGeneration() != gen) {
+      /* Back to the state before the compacting write.*/
+      CHECK(eepromLoad(snapshot) == 0);
+      storeInit();
+      return;
+    }
+    (*value)++;
+  }
+}
+
+/*==========================================================================*/
+/* Tests.                                                                   */
+/*==========================================================================*/
+
+static void test_startup(void) {
+  uint8_t value = 1;
+  unsigned long reads;
+
+  format();
+  reset();
+  CHECK(holds(KEY_A, 0x01));
+  CHECK(holds(KEY_B, 0x42));
+  CHECK(holds(KEY_C, 0x17));
+  CHECK(storeGetSize(4) == -1);
+
+  /* Worst case: a full bank to scan.*/
+  fill_bank(&value);
+  eepromResetCounters();
+  reset();
+  reads = eepromGetReads();
+  CHECK(holds(KEY_A, value));
+  CHECK(reads <= (STORE_SIZE / 2) + 8);
+
+  printf("startup: full bank scanned in %lu EEPROM reads\n", reads);
+}
+
+static void test_torn_writes(void) {
+  unsigned long n;
+
+  format();
+  CHECK(eepromSave(snapshot) == 0);
+  n = torn(0x01, 0x02);
+
+  printf("torn writes: power lost at each of the %lu byte writes\n", n);
+}
+
+static void test_compaction(void) {
+  uint8_t value = 1;
+  uint8_t gen;
+  unsigned long n;
+
+  format();
+  fill_bank(&value);
+  gen = storeGetGeneration();
+  n = torn(value, (uint8_t)(value + 1));
+
+  /* The complete write compacted the bank.*/
+  CHECK(storeGetGeneration() == (uint8_t)(gen + 1));
+
+  printf("compaction: power lost at each of the %lu byte writes\n", n);
+}
+
+static void test_wrap_around(void) {
+  uint8_t value = 1;
+  unsigned compactions = 0;
+  uint8_t gen;
+
+  format();
+  while (compactions < 300) {
+    fill_bank(&value);
+    gen = storeGetGeneration();
+
+    /* A torn compaction right at the wrap.*/
+    if (gen == 0xFF) {
+      CHECK(eepromSave(snapshot) == 0);
+      (void)torn(value, (uint8_t)(value + 1));
+    }
+
+    value++;
+    CHECK(put(KEY_A, value));
+    CHECK(storeGetGeneration() == (uint8_t)(gen + 1));
+    compactions++;
+
+    reset();
+    CHECK(storeGetGeneration() == (uint8_t)(gen + 1));
+    CHECK(holds(KEY_A, value));
+    CHECK(holds(KEY_B, 0x42));
+    CHECK(holds(KEY_C, 0x17));
+  }
+
+  printf("wrap-around: %u compactions, generation %u\n", compactions,
+         storeGetGeneration());
+}
+
+static void test_parts(void) {
+  static const uint8_t show[5] = {1, 2, 3, 4, 5};
+  uint8_t buf[5];
+
+  format();
+  host_time = 0;
+  CHECK(storeWriteBegin(8, sizeof(show)));
+  CHECK(storeWriteData(show, 3));
+
+  /* A setting waits for the upload.*/
+  host_time += MS2ST(100);
+  CHECK(!put(KEY_B, 0x43));
+  CHECK(storeWriteData(&show[3], 2));
+  CHECK(storeWriteEnd());
+  CHECK(put(KEY_B, 0x43));
+  reset();
+  CHECK(storeRead(8, 0, buf, sizeof(buf)) == sizeof(show));
+  CHECK(memcmp(buf, show, sizeof(show)) == 0);
+  CHECK(holds(KEY_B, 0x43));
+
+  /* An abandoned upload stops blocking the settings.*/
+  CHECK(storeWriteBegin(8, sizeof(show)));
+  CHECK(storeWriteData(show, 3));
+  host_time += MS2ST(3000);
+  CHECK(put(KEY_B, 0x44));
+  CHECK(!storeWriteEnd());
+  reset();
+  CHECK(holds(KEY_B, 0x44));
+  CHECK(storeRead(8, 0, buf, sizeof(buf)) == sizeof(show));
+
+  /* A new upload replaces an abandoned one.*/
+  CHECK(storeWriteBegin(8, 2));
+  CHECK(storeWriteBegin(8, 2));
+  CHECK(storeWriteData(show, 2));
+  CHECK(storeWriteEnd());
+  CHECK(storeGetSize(8) == 2);
+
+  printf("parts: uploads kept, abandoned ones dropped\n");
+}
+
+static void test_endurance(void) {
+  uint8_t value = 1, gen;
+  unsigned long worst = 0, n = 0;
+  unsigned compactions = 0;
+  uint16_t addr;
+
+  format();
+  eepromResetCounters();
+  gen = storeGetGeneration();
+  while (compactions < 100) {
+    value++;
+    CHECK(put(KEY_A, value));
+    n++;
+    if (storeGetGeneration() != gen) {
+      gen = storeGetGeneration();
+      compactions++;
+    }
+  }
+
+  for (addr = 0; addr <= E2END; addr++) {
+    if (eepromGetWrites(addr) > worst)
+      worst = eepromGetWrites(addr);
+  }
+
+  /* Each bank is filled once every two compactions, a cell is written a
+     few times per fill at most.*/
+  CHECK(worst <= (2UL * (compactions + 2)));
+
+  printf("endurance: %lu writes, %u compactions, worst cell written %lu "
+         "times, %.1f settings written per worst cell write\n", n,
+         compactions, worst, (double)n / worst);
+}
+
+/*
+ * Tool entry point.
+ */
+int main(int argc, char **argv) {
+
+  if (argc > 1)
+    eep = argv[1];
+
+  test_startup();
+  test_torn_writes();
+  test_compaction();
+  test_wrap_around();
+  test_parts();
+  test_endurance();
+
+  remove(snapshot);
+  if (failures > 0) {
+    printf("%d checks failed\n", failures);
+    return 1;
+  }
+  printf("all store tests passed\n");
+
+  return 0;
+}
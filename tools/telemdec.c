@@ -0,0 +1,176 @@
+/**
+ *
+ * @file    telemdec.c
+ *
+ * @brief   Led cube telemetry stream decoder.
+ *
+ * @details Reads the telemetry records sent on the serial port of a cube,
+ *          see telemetry.h for their format, and prints one line per
+ *          record. The other bytes of the stream, like text lines, are
+ *          skipped, a record start with a bad CRC is counted as such. A gap
+ *          in the sequence numbers is reported as lost records.
+ *
+ *          Usage: telemdec [-f frames] [-s bytes] [port or capture]
+ *          - -f: first asks the cube for a record every number of frames,
+ *          - -s: warns when less than this number of stack bytes stayed
+ *            unused, 16 by default,
+ *          - port or capture: serial port of the cube, opened through the
+ *            cuberpc library, or file saved from it. The default is
+ *            $CUBE_PORT, /dev/ttyACM0 otherwise.
+ *          .
+ *          The exit status is 1 when a record had a bad CRC or a stack
+ *          went below the limit, 2 on error.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Local files. */
+#include "cuberpc.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Usage message.
+ */
+#define USAGE "usage: telemdec [-f frames] [-s bytes] [port or capture]\n"
+
+/**
+ * @name    Record layout, see telemetry.h
+ * @{
+ */
+#define TELEMETRY_RECORD          0xA7
+#define TELEMETRY_SIZE            15
+/** @} */
+
+/**
+ * @brief   Microseconds of the longest interrupt unit, F_CPU / 8 cycles at
+ *          16 MHz.
+ */
+#define TELEMETRY_ISR_US          0.5
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Prints a record.
+ */
+static void print_record(const uint8_t *rec) {
+  unsigned ms = rec[2] | (rec[3] << 8);
+  unsigned scans = rec[5] | (rec[6] << 8);
+
+  printf("%3u %5u ms %3u frames", rec[1], ms, rec[4]);
+  if (ms > 0)
+    printf(" %5.1f fps %6.1f scans/s", (rec[4] * 1000.0) / ms,
+           (scans * 1000.0) / ms);
+  printf(" missed %u/%u isr %.1f us idle %u%% overruns %u stack %u/%u\n",
+         rec[7], rec[8], rec[9] * TELEMETRY_ISR_US, rec[10], rec[11], rec[12],
+         rec[13]);
+}
+
+/*
+ * Tool entry point.
+ */
+int main(int argc, char **argv) {
+  uint8_t rec[TELEMETRY_SIZE];
+  uint8_t data[CUBE_RPC_DATA_SIZE] = {0};
+  const char *port = getenv("CUBE_PORT");
+  long records = 0, bad = 0, lost = 0;
+  int frames = -1, limit = 16, low = 0, seq = -1;
+  int opt, fd, c, n = 0;
+  FILE *f;
+
+  if (port == NULL)
+    port = "/dev/ttyACM0";
+
+  while ((opt = getopt(argc, argv, "f:s:")) != -1) {
+    if (opt == 'f')
+      frames = atoi(optarg);
+    else if (opt == 's')
+      limit = atoi(optarg);
+    else {
+      fprintf(stderr, USAGE);
+      return 2;
+    }
+  }
+  if ((argc - optind) > 1) {
+    fprintf(stderr, USAGE);
+    return 2;
+  }
+  if (optind < argc)
+    port = argv[optind];
+
+  /* A capture may be read only, it is not a terminal anyway.*/
+  if (((fd = cubeOpen(port)) < 0) && ((fd = open(port, O_RDONLY)) < 0)) {
+    perror(port);
+    return 2;
+  }
+  if (frames >= 0) {
+    data[0] = (uint8_t)frames;
+    if (cubeCall(fd, CUBE_CMD_TELEMETRY, data, NULL) != CUBE_OK) {
+      fprintf(stderr, "%s: telemetry not started\n", port);
+      cubeClose(fd);
+      return 2;
+    }
+  }
+  if ((f = fdopen(fd, "rb")) == NULL) {
+    perror(port);
+    cubeClose(fd);
+    return 2;
+  }
+  setvbuf(stdout, NULL, _IOLBF, 0);
+
+  while ((c = getc(f)) != EOF) {
+    if ((n == 0) && (c != TELEMETRY_RECORD))
+      continue;
+    rec[n++] = (uint8_t)c;
+    if (n < TELEMETRY_SIZE)
+      continue;
+
+    if (cubeCrc(rec, TELEMETRY_SIZE - 1) != rec[TELEMETRY_SIZE - 1]) {
+      /* Likely a byte of something else, looks for a record after it.*/
+      bad++;
+      for (n = 1; (n < TELEMETRY_SIZE) && (rec[n] != TELEMETRY_RECORD); n++)
+        ;
+      memmove(rec, &rec[n], TELEMETRY_SIZE - n);
+      n = TELEMETRY_SIZE - n;
+      continue;
+    }
+    n = 0;
+
+    if ((seq >= 0) && (rec[1] != (uint8_t)(seq + 1))) {
+      printf("lost %u records\n", (uint8_t)(rec[1] - seq - 1));
+      lost += (uint8_t)(rec[1] - seq - 1);
+    }
+    seq = rec[1];
+    records++;
+    print_record(rec);
+
+    if ((rec[12] < limit) || (rec[13] < limit)) {
+      printf("warning: less than %d stack bytes left\n", limit);
+      low = 1;
+    }
+  }
+
+  fclose(f);
+  printf("%ld records, %ld lost, %ld bad CRC\n", records, lost, bad);
+
+  return ((bad > 0) || low) ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+#!/bin/sh
+##############################################################################
+#
+# @file   tracecase.sh
+#
+# @brief  Frame trace regression cases of the led cube animations.
+#
+# @details Each animation drawing frames (@1 to @6, the demo of the ledcube
+#          driver drives the pins itself) is a case: it is selected on a
+#          cube built with TRACE_ENABLE, its trace is captured for a while
+#          and compared to the reference kept in cases/. With -u the
+#          captures become the new references.
+#
+#          Usage: tracecase.sh [-u] port [animation...]
+#          Environment: SECONDS_PER_CASE (5), FRAMES compared (100),
+#          TOLERANCE in system ticks (1).
+#
+# @author Theodore Ateba, tfateba@gmail.com
+#
+##############################################################################
+
+TOOLS=$(dirname "$0")
+CASES="$TOOLS/cases"
+SECONDS_PER_CASE=${SECONDS_PER_CASE:-5}
+FRAMES=${FRAMES:-100}
+TOLERANCE=${TOLERANCE:-1}
+UPDATE=no
+
+if [ "$1" = "-u" ]; then
+  UPDATE=yes
+  shift
+fi
+if [ $# -lt 1 ]; then
+  echo "usage: tracecase.sh [-u] port [animation...]" >&2
+  exit 2
+fi
+PORT=$1
+shift
+ANIMATIONS=${*:-1 2 3 4 5 6}
+
+stty -F "$PORT" 38400 raw -echo || exit 2
+mkdir -p "$CASES"
+
+failed=0
+for anim in $ANIMATIONS; do
+  capture=$(mktemp)
+
+  # Captures from the start of the animation on.
+  cat "$PORT" > "$capture" &
+  reader=$!
+  printf '@%s\n' "$anim" > "$PORT"
+  sleep "$SECONDS_PER_CASE"
+  kill "$reader"
+  wait "$reader" 2> /dev/null
+
+  if [ "$UPDATE" = "yes" ]; then
+    mv "$capture" "$CASES/anim$anim.trace"
+    echo "anim$anim: reference updated"
+    continue
+  fi
+
+  if [ ! -f "$CASES/anim$anim.trace" ]; then
+    echo "anim$anim: no reference, run with -u first"
+    failed=1
+  elif "$TOOLS/tracecmp" -t "$TOLERANCE" -n "$FRAMES" \
+       "$CASES/anim$anim.trace" "$capture" > /dev/null; then
+    echo "anim$anim: ok"
+  else
+    echo "anim$anim: differs"
+    "$TOOLS/tracecmp" -t "$TOLERANCE" -n "$FRAMES" \
+      "$CASES/anim$anim.trace" "$capture"
+    failed=1
+  fi
+  rm -f "$capture"
+done
+
+exit $failed
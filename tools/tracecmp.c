@@ -0,0 +1,351 @@
+/**
+ *
+ * @file    tracecmp.c
+ *
+ * @brief   Led cube frame trace replay and compare tool.
+ *
+ * @details Reads the frame traces captured on the serial port of a cube
+ *          built with TRACE_ENABLE, see trace.h for the records.
+ *          With one file the trace is replayed as text, one record per
+ *          line. With two files the second one is compared to the first
+ *          one, the reference: both must have the same records with the
+ *          same payloads, and time stamps which differ by at most the
+ *          tolerance. The first difference is reported.
+ *          The comparison starts at the first start record of each file,
+ *          the bytes found between the records, like text lines, are
+ *          skipped.
+ *
+ *          Usage: tracecmp [-t ticks] [-n frames] reference [capture]
+ *          - -t: time tolerance in system ticks, 0 by default,
+ *          - -n: number of committed frames compared, all by default.
+ *          .
+ *          The exit status is 1 when the traces differ, 2 on error.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @name    Trace records types and sizes, see trace.h
+ * @{
+ */
+#define TRACE_START               0xA0
+#define TRACE_COMMIT              0xA1
+#define TRACE_SHOW                0xA2
+#define TRACE_LAYER               0xA3
+#define TRACE_GRAY                0xA9
+#define TRACE_LAYERS_OFF          0x0F
+/** @} */
+
+/**
+ * @name    Other binary records sent on the serial port, skipped
+ * @{
+ */
+#define RPC_REPLY                 0xA4
+#define RPC_REPLY_SIZE            9
+#define SYNC_TICK                 0xA6
+#define SYNC_TICK_SIZE            5
+#define TELEMETRY_RECORD          0xA7
+#define TELEMETRY_SIZE            15
+#define TIMECODE_FRAME            0xA8
+#define TIMECODE_FRAME_SIZE       6
+/** @} */
+
+/**
+ * @brief   Voxels of a committed frame.
+ */
+#define TRACE_COLUMNS             9
+#define TRACE_LAYERS              3
+
+/**
+ * @brief   Most bit planes of a gray record, levels printed as one hex digit.
+ */
+#define TRACE_PLANES              4
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Decoded trace record.
+ */
+typedef struct {
+  uint8_t   type;
+  uint16_t  ticks;
+  uint8_t   data[1 + 4 * TRACE_PLANES];
+  uint8_t   size;
+  /* Position in the file.*/
+  long      pos;
+} record_t;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Returns the payload size of a trace record, -1 if the byte does
+ *          not start a trace record. A gray record is 1 byte long until its
+ *          number of planes is read.
+ */
+static int payload_size(int type) {
+
+  switch (type) {
+  case TRACE_GRAY:
+    return 1;
+  case TRACE_START:
+    return 1;
+  case TRACE_COMMIT:
+    return 4;
+  case TRACE_SHOW:
+    return 0;
+  case TRACE_LAYER:
+    return 4;
+  default:
+    return -1;
+  }
+}
+
+/**
+ * @brief   Reads the next trace record.
+ *
+ * @param[in] f     trace file
+ * @param[out] rp   record
+ * @return          0 at the end of the file.
+ */
+static int read_record(FILE *f, record_t *rp) {
+  uint8_t buf[2 + 1 + 4 * TRACE_PLANES];
+  int c, n;
+
+  while ((c = getc(f)) != EOF) {
+    /* Other binary records are skipped as a whole.*/
+    if (c == RPC_REPLY) {
+      n = RPC_REPLY_SIZE - 1;
+    }
+    else if (c == SYNC_TICK) {
+      n = SYNC_TICK_SIZE - 1;
+    }
+    else if (c == TELEMETRY_RECORD) {
+      n = TELEMETRY_SIZE - 1;
+    }
+    else if (c == TIMECODE_FRAME) {
+      n = TIMECODE_FRAME_SIZE - 1;
+    }
+    else if ((n = payload_size(c)) >= 0) {
+      rp->pos  = ftell(f) - 1;
+      rp->type = (uint8_t)c;
+      rp->size = (uint8_t)n;
+      if (fread(buf, 1, 2 + n, f) != (size_t)(2 + n))
+        return 0;
+      rp->ticks = buf[0] | (buf[1] << 8);
+      memcpy(rp->data, &buf[2], n);
+      if (c == TRACE_GRAY) {
+        /* Not a number of planes, the bytes of something else.*/
+        if ((rp->data[0] < 2) || (rp->data[0] > TRACE_PLANES))
+          continue;
+        n = 4 * rp->data[0];
+        if (fread(&rp->data[1], 1, n, f) != (size_t)n)
+          return 0;
+        rp->size += (uint8_t)n;
+      }
+      return 1;
+    }
+    else {
+      continue;
+    }
+    if (fread(buf, 1, n, f) != (size_t)n)
+      return 0;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief   Prints a record as text.
+ */
+static void print_record(FILE *out, const record_t *rp) {
+  uint32_t packed, planes[TRACE_PLANES];
+  int b, c, z, level;
+
+  fprintf(out, "%6u ", rp->ticks);
+  switch (rp->type) {
+  case TRACE_START:
+    fprintf(out, "start  animation %u\n", rp->data[0]);
+    break;
+  case TRACE_COMMIT:
+    /* Bit 3 * c + z is the voxel z of the column c.*/
+    packed = rp->data[0] | (rp->data[1] << 8) | (rp->data[2] << 16) |
+             ((uint32_t)rp->data[3] << 24);
+    fprintf(out, "commit");
+    for (z = 0; z < TRACE_LAYERS; z++) {
+      fputc(' ', out);
+      for (c = 0; c < TRACE_COLUMNS; c++)
+        fputc((packed & (1UL << ((3 * c) + z))) ? '#' : '.', out);
+    }
+    fputc('\n', out);
+    break;
+  case TRACE_GRAY:
+    /* Bit planes as commit records, the least significant first.*/
+    for (b = 0; b < rp->data[0]; b++)
+      planes[b] = rp->data[1 + 4 * b] | (rp->data[2 + 4 * b] << 8) |
+                  (rp->data[3 + 4 * b] << 16) |
+                  ((uint32_t)rp->data[4 + 4 * b] << 24);
+    fprintf(out, "gray  ");
+    for (z = 0; z < TRACE_LAYERS; z++) {
+      fputc(' ', out);
+      for (c = 0; c < TRACE_COLUMNS; c++) {
+        level = 0;
+        for (b = rp->data[0]; b > 0; b--)
+          level = (level << 1) | ((planes[b - 1] >> ((3 * c) + z)) & 1);
+        fputc((level == 0) ? '.' : "0123456789ABCDEF"[level], out);
+      }
+    }
+    fprintf(out, " %u planes\n", rp->data[0]);
+    break;
+  case TRACE_SHOW:
+    fprintf(out, "show\n");
+    break;
+  case TRACE_LAYER:
+    if ((rp->data[0] & 0x0F) == TRACE_LAYERS_OFF)
+      fprintf(out, "layer  off     ");
+    else
+      fprintf(out, "layer  %u plane %u", rp->data[0] & 0x0F, rp->data[0] >> 4);
+    fprintf(out, " B=%02X C=%02X D=%02X\n", rp->data[1], rp->data[2],
+            rp->data[3]);
+    break;
+  }
+}
+
+/**
+ * @brief   Prints a difference between the reference and the capture.
+ */
+static void print_difference(const char *what, const record_t *ref,
+                             const record_t *cap) {
+
+  printf("%s\n", what);
+  printf("reference at %ld: ", ref->pos);
+  print_record(stdout, ref);
+  printf("capture at %ld:   ", cap->pos);
+  print_record(stdout, cap);
+}
+
+/**
+ * @brief   Compares a capture to a reference.
+ *
+ * @return  0 when they are the same.
+ */
+static int compare(FILE *reference, FILE *capture, int tolerance,
+                   long frames) {
+  record_t ref, cap;
+  int has_ref, has_cap, delta;
+  long records = 0, commits = 0;
+
+  /* The records before the start of the animation are not compared.*/
+  do {
+    has_ref = read_record(reference, &ref);
+  } while (has_ref && (ref.type != TRACE_START));
+  do {
+    has_cap = read_record(capture, &cap);
+  } while (has_cap && (cap.type != TRACE_START));
+
+  while (1) {
+    if ((frames >= 0) && (commits >= frames))
+      break;
+    if (!has_ref && !has_cap)
+      break;
+    if (!has_ref || !has_cap) {
+      printf("%s ends after %ld records\n",
+             has_ref ? "capture" : "reference", records);
+      return 1;
+    }
+    if ((ref.type != cap.type) || (ref.size != cap.size) ||
+        (memcmp(ref.data, cap.data, ref.size) != 0)) {
+      print_difference("records differ", &ref, &cap);
+      return 1;
+    }
+    delta = (int16_t)(cap.ticks - ref.ticks);
+    if ((delta > tolerance) || (delta < -tolerance)) {
+      print_difference("time stamps differ", &ref, &cap);
+      return 1;
+    }
+    records++;
+    if ((ref.type == TRACE_COMMIT) || (ref.type == TRACE_GRAY))
+      commits++;
+    has_ref = read_record(reference, &ref);
+    has_cap = read_record(capture, &cap);
+  }
+
+  printf("%ld records, %ld frames identical\n", records, commits);
+  return 0;
+}
+
+/*
+ * Tool entry point.
+ */
+int main(int argc, char **argv) {
+  FILE *reference, *capture;
+  record_t rec;
+  long frames = -1;
+  int tolerance = 0;
+  int opt, status;
+
+  while ((opt = getopt(argc, argv, "t:n:")) != -1) {
+    switch (opt) {
+    case 't':
+      tolerance = atoi(optarg);
+      break;
+    case 'n':
+      frames = atol(optarg);
+      break;
+    default:
+      fprintf(stderr,
+              "usage: tracecmp [-t ticks] [-n frames] reference [capture]\n");
+      return 2;
+    }
+  }
+  if ((optind >= argc) || ((argc - optind) > 2)) {
+    fprintf(stderr,
+            "usage: tracecmp [-t ticks] [-n frames] reference [capture]\n");
+    return 2;
+  }
+
+  if ((reference = fopen(argv[optind], "rb")) == NULL) {
+    perror(argv[optind]);
+    return 2;
+  }
+
+  /* Replay.*/
+  if ((argc - optind) == 1) {
+    while (read_record(reference, &rec))
+      print_record(stdout, &rec);
+    fclose(reference);
+    return 0;
+  }
+
+  if ((capture = fopen(argv[optind + 1], "rb")) == NULL) {
+    perror(argv[optind + 1]);
+    fclose(reference);
+    return 2;
+  }
+  status = compare(reference, capture, tolerance, frames);
+  fclose(reference);
+  fclose(capture);
+
+  return status;
+}
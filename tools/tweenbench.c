@@ -0,0 +1,314 @@
+/**
+ *
+ * @file    tweenbench.c
+ *
+ * @brief   Host benchmark of the keyframe animation.
+ *
+ * @details Builds tween.c and display.c on the host, the ports are plain
+ *          variables and the scan timer is fired by the benchmark after
+ *          each frame, long enough for the frame to be swapped in. The
+ *          commits of tween.c are renamed at its build and timed here: the
+ *          interpolated frames are committed once with the voxels they
+ *          change, see displayCommitVoxels(), and once whole. Prints:
+ *          - the flash of the keyframes and the flash the same loop takes
+ *            as whole grayscale frames,
+ *          - the interpolated frames left unchanged by the rounding of the
+ *            levels,
+ *          - for both commits, the layers converted per interpolated frame,
+ *            the work the target does, and the time of the commit of an
+ *            interpolated frame on the host, the best of @p BENCH_RUNS runs
+ *            less the time of the clock read.
+ *          .
+ *          Both commits must write the same values on the ports.
+ *
+ *          Usage: tweenbench
+ *          The exit status is 1 when the port writes differ.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Firmware files. */
+#include "display.h"
+#include "tween.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Loops of the animation per run and runs timed for each commit.
+ */
+#define BENCH_LOOPS               100
+#define BENCH_RUNS                5
+
+/**
+ * @brief   Most frames of the loop of the animation.
+ */
+#define MAX_FRAMES                256
+
+/**
+ * @brief   Scan timer events after each frame, a few scans.
+ */
+#define SCAN_EVENTS               (4 * DISPLAY_LAYERS * (DISPLAY_GRAY_BITS + 2))
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Registers of the display driver, see host/avr/io.h
+ */
+volatile uint8_t PORTB, PORTC, PORTD;
+volatile uint8_t DDRB, DDRC, DDRD;
+volatile uint8_t TCCR2A, TCCR2B, TCNT2;
+
+/**
+ * @brief   System time of the firmware modules, see host/ch.h
+ */
+systime_t host_time;
+
+/**
+ * @brief   Benchmark state.
+ */
+static struct {
+  /* Scan timer and its delay.*/
+  virtual_timer_t *timer;
+  systime_t       delay;
+  /* Interpolated frames committed whole.*/
+  bool            whole;
+  /* Frames played, keyframes among them, and frames of the reference.*/
+  uint32_t        frames;
+  uint32_t        keys;
+  display_gray_t  played[2 * MAX_FRAMES];
+  /* Interpolated frames, their commit time and the layers they change.*/
+  uint32_t        tweens;
+  uint64_t        ns;
+  uint32_t        layers;
+  /* Time of a clock read.*/
+  uint64_t        clock_ns;
+  /* Committed frames identical to the previous one.*/
+  uint16_t        unchanged;
+  /* Hash of the port writes.*/
+  uint32_t        hash;
+} bench;
+
+/*==========================================================================*/
+/* Emulation.                                                               */
+/*==========================================================================*/
+
+void chVTSetI(virtual_timer_t *vtp, systime_t delay, vtfunc_t vtfunc,
+              void *par) {
+
+  vtp->func   = vtfunc;
+  vtp->par    = par;
+  bench.timer = vtp;
+  bench.delay = delay;
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000U + ts.tv_nsec;
+}
+
+/**
+ * @brief   Notes the frames played, the first ones are the reference.
+ */
+static void note_frame(const display_gray_t *gp) {
+
+  if (bench.frames < (2 * MAX_FRAMES))
+    bench.played[bench.frames] = *gp;
+  bench.frames++;
+}
+
+/* Commits of tween.c, renamed at its build.*/
+void benchCommitGray(const display_gray_t *gp) {
+
+  note_frame(gp);
+  bench.keys++;
+  displayCommitGray(gp);
+}
+
+void benchCommitVoxels(const display_gray_t *gp, const uint8_t *voxels,
+                       uint8_t n) {
+  uint64_t start;
+  uint8_t layers = 0;
+
+  note_frame(gp);
+  start = now_ns();
+  if (bench.whole)
+    displayCommitGray(gp);
+  else
+    displayCommitVoxels(gp, voxels, n);
+  bench.ns += now_ns() - start - bench.clock_ns;
+  bench.tweens++;
+
+  /* The voxels listed by tween.c all changed.*/
+  while (n > 0)
+    layers |= 1U << (voxels[--n] % DISPLAY_LAYERS);
+  for (; layers != 0; layers >>= 1)
+    bench.layers += layers & 1U;
+}
+
+/**
+ * @brief   Fires the scan timer, the port values written are hashed.
+ */
+static void scan(void) {
+  virtual_timer_t *vtp;
+  uint8_t k;
+
+  for (k = 0; k < SCAN_EVENTS; k++) {
+    vtp = bench.timer;
+    host_time += bench.delay;
+    vtp->func(vtp->par);
+    bench.hash = (bench.hash ^ PORTB) * 16777619U;
+    bench.hash = (bench.hash ^ PORTC) * 16777619U;
+    bench.hash = (bench.hash ^ PORTD) * 16777619U;
+  }
+}
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Plays the animation from its start, a frame per scan.
+ *
+ * @param[in] whole     interpolated frames committed whole
+ * @param[in] frames    frames to play
+ */
+static void play(bool whole, uint32_t frames) {
+  display_stats_t stats;
+  uint64_t clock_ns = bench.clock_ns;
+  uint32_t k;
+
+  memset(&bench, 0, sizeof(bench));
+  bench.whole    = whole;
+  bench.clock_ns = clock_ns;
+  bench.hash     = 2166136261U;
+
+  displayInit();
+  displayStart();
+  tweenStart();
+  for (k = 0; k < frames; k++) {
+    (void)tweenStep();
+    scan();
+  }
+  displayStop();
+  displayGetStatsI(&stats);
+  bench.unchanged = stats.unchanged;
+}
+
+/**
+ * @brief   Measures the time of a clock read.
+ */
+static void calibrate(void) {
+  uint64_t start = now_ns();
+  uint32_t k;
+
+  for (k = 0; k < 100000; k++)
+    (void)now_ns();
+  bench.clock_ns = (now_ns() - start) / 100000;
+}
+
+/**
+ * @brief   Finds the loop of the animation in the frames played.
+ *
+ * @return  the frames of the loop, the shortest sequence played again and
+ *          again.
+ */
+static uint16_t find_loop(void) {
+  uint16_t k, n;
+
+  for (n = 1; n < MAX_FRAMES; n++) {
+    for (k = 0; (k < MAX_FRAMES) &&
+         (memcmp(&bench.played[k], &bench.played[k + n],
+                 sizeof(display_gray_t)) == 0); k++)
+      ;
+    if (k == MAX_FRAMES)
+      break;
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Plays the loop of the animation with one of the commits.
+ *
+ * @param[in] whole     interpolated frames committed whole
+ * @param[in] frames    frames of the loop
+ * @return              the best time of the commit of an interpolated
+ *                      frame, in ns.
+ */
+static double measure(bool whole, uint16_t frames) {
+  double ns, best = 0.0;
+  uint8_t k;
+
+  for (k = 0; k < BENCH_RUNS; k++) {
+    play(whole, (uint32_t)BENCH_LOOPS * frames);
+    ns = (double)(int64_t)bench.ns / bench.tweens;
+    if ((k == 0) || (ns < best))
+      best = ns;
+  }
+
+  return best;
+}
+
+/*
+ * Tool entry point.
+ */
+int main(void) {
+  uint32_t hash, keys, tweens, layers;
+  uint16_t frames, unchanged;
+  double partial, whole;
+
+  calibrate();
+  play(false, 2 * MAX_FRAMES);
+  frames = find_loop();
+  play(false, frames);
+  keys = bench.keys;
+  printf("%u frames, %lu keyframes: %lu bytes of keyframes, %lu bytes as "
+         "frames, %lu bytes saved\n", frames, (unsigned long)keys,
+         (unsigned long)(keys * sizeof(tween_key_t)),
+         (unsigned long)(frames * sizeof(display_gray_t)),
+         (unsigned long)(frames * sizeof(display_gray_t) -
+                         keys * sizeof(tween_key_t)));
+
+  partial   = measure(false, frames);
+  hash      = bench.hash;
+  tweens    = bench.tweens;
+  layers    = bench.layers;
+  unchanged = bench.unchanged;
+
+  /* Keyframes are never unchanged in this animation, the frames left
+     unchanged are interpolated ones.*/
+  whole = measure(true, frames);
+  printf("%lu interpolated frames, %.0f%% unchanged\n",
+         (unsigned long)tweens, (100.0 * unchanged) / tweens);
+  printf("voxel commit: %.2f layers converted per frame, %.1f ns\n",
+         (double)layers / tweens, partial);
+  printf("whole commit: %.2f layers converted per frame, %.1f ns\n",
+         ((double)(tweens - bench.unchanged) * DISPLAY_LAYERS) / tweens,
+         whole);
+
+  if (bench.hash != hash) {
+    printf("the port writes differ\n");
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+/**
+ *
+ * @file    trace.c
+ *
+ * @brief   Led cube frame trace recorder source file.
+ *
+ * @details Records are put in the SD1 output queue only when they fit as a
+ *          whole, the recorder never waits so it cannot disturb the timing
+ *          it records. Records that do not fit are counted as dropped.
+ *          Nothing is written from the refresh interrupt, the show time and
+ *          the layer writes of the first scan of a frame are only noted
+ *          there and sent by the animation thread.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* Standard files. */
+#include <string.h>
+
+/* Project local files. */
+#include "sio.h"
+#include "trace.h"
+
+#if (TRACE_ENABLE == TRUE) || defined(__DOXYGEN__)
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Most layer writes in a scan, each layer is switched on, gets its
+ *          bit planes then is switched off.
+ */
+#define TRACE_LAYER_WRITES        (DISPLAY_LAYERS * (DISPLAY_GRAY_BITS + 1))
+
+/**
+ * @brief   Largest record payload, a grayscale frame.
+ */
+#define TRACE_MAX_PAYLOAD         (1 + 4 * DISPLAY_GRAY_BITS)
+
+/* A record is only queued when all of it fits in the output queue.*/
+#if (3 + TRACE_MAX_PAYLOAD) > SERIAL_BUFFERS_SIZE
+#error "a gray record must fit in the SD1 output queue"
+#endif
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Layer write noted by the refresh interrupt.
+ */
+typedef struct {
+  systime_t       time;
+  uint8_t         write;
+  display_image_t image;
+} trace_layer_t;
+
+/**
+ * @brief   Recorder state.
+ */
+static struct {
+  /* Start time of the animation being traced.*/
+  systime_t epoch;
+  /* Time the last committed frame was shown.*/
+  systime_t shown;
+  /* A show record is waiting to be sent.*/
+  bool      pending;
+  /* Layer writes of the first scan of the shown frame, being noted until
+     the count is reached.*/
+  trace_layer_t layers[TRACE_LAYER_WRITES];
+  uint8_t   noted;
+  uint8_t   count;
+  /* The layer writes are being sent, none is noted.*/
+  bool      sending;
+  /* Records which did not fit in the output queue.*/
+  uint16_t  dropped;
+} trace;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Queues a record on SD1 without waiting.
+ *
+ * @param[in] type  record type
+ * @param[in] time  record time stamp
+ * @param[in] data  record payload
+ * @param[in] n     payload size
+ */
+static void trace_put(uint8_t type, systime_t time,
+                      const uint8_t *data, uint8_t n) {
+  uint8_t rec[3 + TRACE_MAX_PAYLOAD];
+  uint8_t i;
+
+  rec[0] = type;
+  rec[1] = (uint8_t)(time - trace.epoch);
+  rec[2] = (uint8_t)((time - trace.epoch) >> 8);
+  for (i = 0; i < n; i++)
+    rec[3 + i] = data[i];
+
+  if (!sioWrite(rec, 3 + n, TIME_IMMEDIATE))
+    trace.dropped++;
+}
+
+/**
+ * @brief   Sends the show record of the previous frame and its layer
+ *          writes, if any.
+ * @note    The layer writes of a scan not over yet are cut short.
+ */
+static void trace_flush(void) {
+  const trace_layer_t *lp;
+  systime_t shown;
+  bool pending;
+  uint8_t noted, i;
+
+  chSysLock();
+  shown = trace.shown;
+  pending = trace.pending;
+  noted = trace.noted;
+  trace.pending = false;
+  trace.noted = 0;
+  trace.count = 0;
+  trace.sending = true;
+  chSysUnlock();
+
+  if (pending)
+    trace_put(TRACE_SHOW, shown, NULL, 0);
+
+  for (i = 0; i < noted; i++) {
+    uint8_t data[1 + DISPLAY_PORTS];
+
+    lp = &trace.layers[i];
+    data[0] = lp->write;
+    memcpy(&data[1], lp->image.out, DISPLAY_PORTS);
+    trace_put(TRACE_LAYER, lp->time, data, sizeof(data));
+  }
+
+  chSysLock();
+  trace.sending = false;
+  chSysUnlock();
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Records the start of an animation and restarts the time base.
+ *
+ * @param[in] id    animation identifier
+ */
+void traceStart(uint8_t id) {
+
+  trace_flush();
+  trace.epoch = chVTGetSystemTime();
+  trace_put(TRACE_START, trace.epoch, &id, 1);
+}
+
+/**
+ * @brief   Records a committed frame, all its bit planes.
+ *
+ * @param[in] fp        pointer to the bit planes of the committed frame
+ * @param[in] depth     number of bit planes, a gray record when more than
+ *                      one
+ */
+void traceCommit(const display_frame_t *fp, uint8_t depth) {
+  uint8_t data[TRACE_MAX_PAYLOAD];
+  uint8_t n = 0;
+  uint32_t packed;
+  uint8_t b, c;
+
+  trace_flush();
+
+  if (depth > 1)
+    data[n++] = depth;
+  for (b = 0; b < depth; b++) {
+    packed = 0;
+    for (c = DISPLAY_COLUMNS; c > 0; c--)
+      packed = (packed << 3) | (fp[b].col[c - 1] & 0x07);
+
+    data[n++] = (uint8_t)packed;
+    data[n++] = (uint8_t)(packed >> 8);
+    data[n++] = (uint8_t)(packed >> 16);
+    data[n++] = (uint8_t)(packed >> 24);
+  }
+
+  trace_put((depth > 1) ? TRACE_GRAY : TRACE_COMMIT, chVTGetSystemTime(),
+            data, n);
+}
+
+/**
+ * @brief   Notes that the last committed frame is now shown.
+ * @note    Called by the refresh engine when it switches on the first
+ *          layer of a new frame, the record itself is sent with the next
+ *          one, it keeps its own time stamp.
+ *          The layer writes of the scan starting now are noted too.
+ *
+ * @param[in] depth     number of bit planes of the frame
+ */
+void traceShowI(uint8_t depth) {
+
+  trace.shown = chVTGetSystemTimeX();
+  trace.pending = true;
+  if (!trace.sending) {
+    trace.noted = 0;
+    trace.count = DISPLAY_LAYERS * (depth + 1);
+  }
+}
+
+/**
+ * @brief   Notes a layer write of the first scan of the shown frame.
+ * @note    Called by the refresh engine each time it switches a layer on,
+ *          loads a bit plane or switches the layers off.
+ *
+ * @param[in] write     layer and bit plane, @p TRACE_LAYERS_OFF in the
+ *                      layer bits when all the layers are switched off
+ * @param[in] ip        pointer to the column pins written
+ */
+void traceLayerI(uint8_t write, const display_image_t *ip) {
+  trace_layer_t *lp;
+
+  if (trace.noted >= trace.count)
+    return;
+
+  lp = &trace.layers[trace.noted++];
+  lp->time  = chVTGetSystemTimeX();
+  lp->write = write;
+  lp->image = *ip;
+}
+
+/**
+ * @brief   Returns the number of records which could not be queued.
+ *
+ * @return  the dropped records count.
+ */
+uint16_t traceGetDropped(void) {
+
+  return trace.dropped;
+}
+
+#endif /* TRACE_ENABLE == TRUE */
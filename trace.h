@@ -0,0 +1,103 @@
+/**
+ *
+ * @file    trace.h
+ *
+ * @brief   Led cube frame trace recorder header file.
+ *
+ * @details When enabled, the frames committed by the animations and the
+ *          moment they are actually shown are streamed on SD1 as binary
+ *          records, all little endian:
+ *          - start:  0xA0, ticks (2 bytes), animation identifier (1 byte),
+ *          - commit: 0xA1, ticks (2 bytes), frame (4 bytes, bit 3 * c + z
+ *                    is the voxel z of column c),
+ *          - show:   0xA2, ticks (2 bytes),
+ *          - layer:  0xA3, ticks (2 bytes), write (1 byte, layer in bits
+ *                    0..3 and bit plane in bits 4..7, layer 15 when all
+ *                    the layers are switched off), column pins of port B,
+ *                    C and D (3 bytes),
+ *          - gray:   0xA9, ticks (2 bytes), number of bit planes (1 byte),
+ *                    each bit plane as the frame of a commit record
+ *                    (4 bytes), the least significant first.
+ *          .
+ *          Grayscale frames are committed with a gray record, the other
+ *          frames with a commit record. A show record follows the commit
+ *          or gray record of its frame, the layer records of the first scan
+ *          of the frame follow it. A gray record must fit in the output
+ *          queue of SD1, more than 3 bit planes need a larger
+ *          SERIAL_BUFFERS_SIZE.
+ *          Ticks are counted from the start of the animation, so two
+ *          captures of the same animation played after a reset are bit
+ *          exact copies unless its output or its timing changed.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+#include "hal.h"
+
+/* Project local files. */
+#include "display.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Enables the frame trace on SD1.
+ * @note    The trace shares SD1 with the other serial users, it is meant
+ *          for test builds: make UDEFS=-DTRACE_ENABLE=TRUE
+ */
+#if !defined(TRACE_ENABLE)
+#define TRACE_ENABLE              FALSE
+#endif
+
+/*==========================================================================*/
+/* Constants.                                                               */
+/*==========================================================================*/
+
+/**
+ * @name    Trace records types
+ * @{
+ */
+#define TRACE_START               0xA0
+#define TRACE_COMMIT              0xA1
+#define TRACE_SHOW                0xA2
+#define TRACE_LAYER               0xA3
+#define TRACE_GRAY                0xA9
+/** @} */
+
+/**
+ * @brief   Write of a layer record switching all the layers off.
+ */
+#define TRACE_LAYERS_OFF          0x0F
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#if (TRACE_ENABLE == TRUE) || defined(__DOXYGEN__)
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void traceStart(uint8_t id);
+  void traceCommit(const display_frame_t *fp, uint8_t depth);
+  void traceShowI(uint8_t depth);
+  void traceLayerI(uint8_t write, const display_image_t *ip);
+  uint16_t traceGetDropped(void);
+#ifdef __cplusplus
+}
+#endif
+#endif /* TRACE_ENABLE == TRUE */
+
+#endif /* _TRACE_H_ */
@@ -0,0 +1,257 @@
+/**
+ *
+ * @file    tween.c
+ *
+ * @brief   Led cube keyframe interpolation source file.
+ *
+ * @details A grayscale animation is a loop of keyframes, each one with the
+ *          number of frames to the next one. When a keyframe is reached the
+ *          voxels which change before the next one are listed with their
+ *          level and their step per frame, in 8.8 fixed point. Each frame
+ *          then only updates the listed voxels, the others keep their bit
+ *          planes as they are. Only the voxels whose rounded level changed
+ *          are committed, the display converts them alone, see
+ *          displayCommitVoxels(). A keyframe is committed whole.
+ *          The first frame of each keyframe is indexed, a seek starts at
+ *          the keyframe before the time and computes the levels of the
+ *          listed voxels at once.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* AVR files. */
+#include <avr/pgmspace.h>
+
+/* Project local files. */
+#include "tween.h"
+
+/*==========================================================================*/
+/* Local constants.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Keyframe with each layer at one level.
+ */
+#define TWEEN_LAYERS(l0, l1, l2, n)                                         \
+  {{(l0) | ((l1) << 4), (l2) | ((l0) << 4), (l1) | ((l2) << 4),             \
+    (l0) | ((l1) << 4), (l2) | ((l0) << 4), (l1) | ((l2) << 4),             \
+    (l0) | ((l1) << 4), (l2) | ((l0) << 4), (l1) | ((l2) << 4),             \
+    (l0) | ((l1) << 4), (l2) | ((l0) << 4), (l1) | ((l2) << 4),             \
+    (l0) | ((l1) << 4), (l2)}, (n)}
+
+/**
+ * @brief   Wave going up the cube then fading in and out.
+ */
+static const tween_key_t tween_keys[] PROGMEM = {
+  TWEEN_LAYERS(0, 0, 0, 25),
+  TWEEN_LAYERS(DISPLAY_GRAY_MAX, 0, 0, 25),
+  TWEEN_LAYERS(0, DISPLAY_GRAY_MAX, 0, 25),
+  TWEEN_LAYERS(0, 0, DISPLAY_GRAY_MAX, 25),
+  TWEEN_LAYERS(DISPLAY_GRAY_MAX, DISPLAY_GRAY_MAX, DISPLAY_GRAY_MAX, 50)
+};
+
+#define TWEEN_KEYS                (sizeof(tween_keys) / sizeof(tween_keys[0]))
+
+/*==========================================================================*/
+/* Local variables and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Level of a voxel changing between two keyframes.
+ */
+typedef struct {
+  /* Level and step per frame, 8.8 fixed point.*/
+  int16_t level;
+  int16_t step;
+} tween_change_t;
+
+/**
+ * @brief   Interpolation state.
+ */
+static struct {
+  /* Frame being played.*/
+  display_gray_t  frame;
+  /* Voxels changing until the next keyframe and their levels.*/
+  uint8_t         voxels[DISPLAY_VOXELS];
+  tween_change_t  changes[DISPLAY_VOXELS];
+  uint8_t         count;
+  /* Voxels whose level changed in the frame.*/
+  uint8_t         dirty[DISPLAY_VOXELS];
+  /* The next frame is committed whole.*/
+  bool            whole;
+  /* Last keyframe reached.*/
+  uint8_t         key;
+  /* Frames played since the keyframe and frames to the next one.*/
+  uint8_t         played;
+  uint8_t         frames;
+  /* Keyframe index, first frame of each keyframe, and number of frames.*/
+  uint16_t        first[TWEEN_KEYS];
+  uint16_t        length;
+} tween;
+
+/*==========================================================================*/
+/* Local functions.                                                         */
+/*==========================================================================*/
+
+/**
+ * @brief   Returns the level of a voxel in a keyframe.
+ *
+ * @param[in] kp    keyframe, in flash
+ * @param[in] v     voxel
+ */
+static uint8_t tween_level(const tween_key_t *kp, uint8_t v) {
+  uint8_t b = pgm_read_byte(&kp->levels[v >> 1]);
+
+  return (v & 1) ? (b >> 4) : (b & 0x0F);
+}
+
+/**
+ * @brief   Shows a keyframe and lists the voxels changing until the next.
+ *
+ * @param[in] key   keyframe
+ */
+static void tween_begin(uint8_t key) {
+  const tween_key_t *kp = &tween_keys[key];
+  const tween_key_t *np = &tween_keys[(key + 1) % TWEEN_KEYS];
+  uint8_t v, frames;
+
+  frames = pgm_read_byte(&kp->frames);
+  if (frames == 0)
+    frames = 1;
+
+  tween.key     = key;
+  tween.played = 0;
+  tween.frames  = frames;
+  tween.count   = 0;
+  tween.whole   = true;
+
+  for (v = 0; v < DISPLAY_VOXELS; v++) {
+    uint8_t from = tween_level(kp, v);
+    uint8_t to = tween_level(np, v);
+
+    displaySetLevel(&tween.frame, v / DISPLAY_LAYERS, v % DISPLAY_LAYERS,
+                    from);
+    if (to != from) {
+      tween_change_t *cp = &tween.changes[tween.count];
+
+      tween.voxels[tween.count++] = v;
+      cp->level = (int16_t)from << 8;
+      cp->step  = (((int16_t)to - from) << 8) / frames;
+    }
+  }
+}
+
+/*==========================================================================*/
+/* Exported functions.                                                      */
+/*==========================================================================*/
+
+/**
+ * @brief   Rewinds the animation to its first keyframe.
+ */
+void tweenStart(void) {
+  uint8_t key, frames;
+
+  tween.length = 0;
+  for (key = 0; key < TWEEN_KEYS; key++) {
+    frames = pgm_read_byte(&tween_keys[key].frames);
+    tween.first[key] = tween.length;
+    tween.length += (frames > 0) ? frames : 1;
+  }
+
+  tween.played = 0;
+  tween.frames  = 0;
+  tween.key     = TWEEN_KEYS - 1;
+}
+
+/**
+ * @brief   Shows the next frame of the animation.
+ *
+ * @return  the time until the next frame.
+ */
+systime_t tweenStep(void) {
+  tween_change_t *cp;
+  uint8_t i, v, level, next, n = 0;
+
+  if (tween.played >= tween.frames) {
+    tween_begin((tween.key + 1) % TWEEN_KEYS);
+  }
+  else {
+    for (i = 0; i < tween.count; i++) {
+      cp = &tween.changes[i];
+      level = (uint8_t)((cp->level + 0x80) >> 8);
+      cp->level += cp->step;
+      next = (uint8_t)((cp->level + 0x80) >> 8);
+      /* After a seek the frame still holds the levels of the keyframe.*/
+      if (!tween.whole && (next == level))
+        continue;
+
+      v = tween.voxels[i];
+      displaySetLevel(&tween.frame, v / DISPLAY_LAYERS, v % DISPLAY_LAYERS,
+                      next);
+      tween.dirty[n++] = v;
+    }
+  }
+  tween.played++;
+
+  /* After a keyframe or a seek the whole frame may differ from the last.*/
+  if (tween.whole) {
+    tween.whole = false;
+    displayCommitGray(&tween.frame);
+  }
+  else {
+    displayCommitVoxels(&tween.frame, tween.dirty, n);
+  }
+
+  return TWEEN_FRAME_PERIOD;
+}
+
+/**
+ * @brief   Moves the next frame to the one shown at a time.
+ * @details Nothing is done when the animation is less than one frame away
+ *          from the time.
+ *
+ * @param[in] ticks time since the start of the animation
+ * @return          false if nothing was done.
+ */
+bool tweenSeek(uint32_t ticks) {
+  tween_change_t *cp;
+  uint16_t frame, next;
+  uint8_t key, i;
+
+  frame = (ticks / TWEEN_FRAME_PERIOD) % tween.length;
+  if (tween.played >= tween.frames)
+    next = tween.first[(tween.key + 1) % TWEEN_KEYS];
+  else
+    next = tween.first[tween.key] + tween.played;
+  if ((frame == next) ||
+      (frame == ((next > 0) ? next - 1 : tween.length - 1)))
+    return false;
+
+  for (key = TWEEN_KEYS - 1; tween.first[key] > frame; key--)
+    ;
+
+  if (frame == tween.first[key]) {
+    /* The next step begins the keyframe.*/
+    tween.key    = (key + TWEEN_KEYS - 1) % TWEEN_KEYS;
+    tween.played = 0;
+    tween.frames = 0;
+  }
+  else {
+    /* The next step adds one more step to the levels.*/
+    tween_begin(key);
+    tween.played = frame - tween.first[key];
+    for (i = 0; i < tween.count; i++) {
+      cp = &tween.changes[i];
+      cp->level += cp->step * (tween.played - 1);
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,66 @@
+/**
+ *
+ * @file    tween.h
+ *
+ * @brief   Led cube keyframe interpolation header file.
+ *
+ * @author  Theodore Ateba, tf.ateba@gmail.com
+ *
+ * @date    18 October 2026
+ *
+ */
+
+#ifndef _TWEEN_H_
+#define _TWEEN_H_
+
+/*==========================================================================*/
+/* Includes files.                                                          */
+/*==========================================================================*/
+
+/* ChibiOS files. */
+#include "ch.h"
+
+/* Project local files. */
+#include "display.h"
+
+/*==========================================================================*/
+/* Configuration.                                                           */
+/*==========================================================================*/
+
+/**
+ * @brief   Time between two interpolated frames, in system ticks.
+ */
+#if !defined(TWEEN_FRAME_PERIOD)
+#define TWEEN_FRAME_PERIOD        MS2ST(20)
+#endif
+
+/*==========================================================================*/
+/* Data structures and types.                                               */
+/*==========================================================================*/
+
+/**
+ * @brief   Keyframe of a grayscale animation, stored in flash.
+ */
+typedef struct {
+  /* Level of each voxel, two per byte, voxel c * DISPLAY_LAYERS + z in the
+     low nibble when even.*/
+  uint8_t levels[(DISPLAY_VOXELS + 1) / 2];
+  /* Frames from this keyframe to the next one.*/
+  uint8_t frames;
+} tween_key_t;
+
+/*==========================================================================*/
+/* External declarations.                                                   */
+/*==========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void tweenStart(void);
+  systime_t tweenStep(void);
+  bool tweenSeek(uint32_t ticks);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TWEEN_H_ */